@@ -0,0 +1,125 @@
+#include "SQLAsyncExecutor.h"
+
+SQLAsyncExecutor::SQLAsyncExecutor(std::shared_ptr<SQLiteWrapper> wrapper) :
+	wrapper(wrapper),
+	sleeping(false),
+	stopRequested(false)
+{
+	//queue always contains one node, its task was already taken
+	Node * stub = new Node();
+	stub->next.store(nullptr, std::memory_order_relaxed);
+	head.store(stub, std::memory_order_relaxed);
+	tail = stub;
+
+	worker = std::thread(&SQLAsyncExecutor::Run, this);
+}
+
+SQLAsyncExecutor::~SQLAsyncExecutor()
+{
+	{
+		std::lock_guard<std::mutex> lock(m);
+		stopRequested.store(true);
+	}
+	cv.notify_one();
+
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+
+	delete tail;
+}
+
+/// <summary>
+/// Run task on the worker thread, without result
+/// </summary>
+/// <param name="task"></param>
+void SQLAsyncExecutor::Post(Task task)
+{
+	this->Enqueue(std::move(task));
+}
+
+/// <summary>
+/// Block until all tasks submitted before this call are done
+/// </summary>
+void SQLAsyncExecutor::WaitForAll()
+{
+	this->Submit([](SQLiteWrapper &) {}).wait();
+}
+
+void SQLAsyncExecutor::Enqueue(Task && task)
+{
+	Node * n = new Node();
+	n->task = std::move(task);
+	n->next.store(nullptr, std::memory_order_relaxed);
+
+	Node * prev = head.exchange(n, std::memory_order_acq_rel);
+	prev->next.store(n, std::memory_order_seq_cst);
+
+	//the worker sets sleeping before it checks the queue for the last time,
+	//so either it sees the new node or we see it sleeping
+	if (sleeping.load(std::memory_order_seq_cst))
+	{
+		std::lock_guard<std::mutex> lock(m);
+		cv.notify_one();
+	}
+}
+
+/// <summary>
+/// Take task from the queue. Called only by the worker thread
+/// </summary>
+/// <param name="task"></param>
+/// <returns>false if queue is empty (or producer has not finished insertion yet)</returns>
+bool SQLAsyncExecutor::Dequeue(Task & task)
+{
+	Node * next = tail->next.load(std::memory_order_acquire);
+	if (next == nullptr)
+	{
+		return false;
+	}
+
+	task = std::move(next->task);
+	delete tail;
+	tail = next;
+	return true;
+}
+
+bool SQLAsyncExecutor::IsEmpty() const
+{
+	return tail->next.load(std::memory_order_seq_cst) == nullptr;
+}
+
+void SQLAsyncExecutor::Run()
+{
+	Task task;
+	while (true)
+	{
+		if (this->Dequeue(task))
+		{
+			//exceptions of Submit tasks are passed via future, 
+			//others must not terminate the worker
+			try
+			{
+				task(*wrapper);
+			}
+			catch (const std::exception & e)
+			{
+				SQL_LOG("SQLAsyncExecutor task failed: %s\n", e.what());
+			}
+			task = nullptr;
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m);
+		sleeping.store(true, std::memory_order_seq_cst);
+		cv.wait(lock, [this] { 
+			return (this->IsEmpty() == false) || stopRequested.load(); 
+		});
+		sleeping.store(false, std::memory_order_relaxed);
+
+		if (this->IsEmpty() && stopRequested.load())
+		{
+			break;
+		}
+	}
+}
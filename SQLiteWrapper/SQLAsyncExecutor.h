@@ -0,0 +1,188 @@
+#ifndef SQLAsyncExecutor_hpp
+#define SQLAsyncExecutor_hpp
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <tuple>
+#include <future>
+#include <functional>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <type_traits>
+#include <utility>
+
+#include "SQLiteWrapper.h"
+#include "SQLResult.h"
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#	if __has_include(<coroutine>)
+#		define SQL_HAS_COROUTINES
+#	endif
+#endif
+
+#ifdef SQL_HAS_COROUTINES
+template <typename T>
+class SQLAsyncRows;
+#endif
+
+/// <summary>
+/// Runs database work on a dedicated worker thread that owns the connection.
+/// Tasks are executed one by one in submission order.
+/// 
+/// Tasks are passed through lock-free MPSC queue, so submitting threads 
+/// never wait for the worker or for each other. Worker sleeps only 
+/// if the queue is empty.
+/// 
+/// Connection must not be used directly by other threads while the executor exists.
+/// Pending tasks are finished in destructor.
+/// 
+/// Usage:
+/// SQLAsyncExecutor exec(db);
+/// auto f = exec.Select<std::tuple<int64_t, std::string>>("SELECT id, name FROM t WHERE id > ?", 10);
+/// exec.Execute("INSERT INTO t VALUES(?, ?)", 1, "a");
+/// exec.Submit([](SQLiteWrapper & db) { return db.GetCount("t", "*", ""); });
+/// </summary>
+class SQLAsyncExecutor
+{
+public:
+	typedef std::function<void(SQLiteWrapper & db)> Task;
+
+	SQLAsyncExecutor(std::shared_ptr<SQLiteWrapper> wrapper);
+	SQLAsyncExecutor(const SQLAsyncExecutor &) = delete;
+	SQLAsyncExecutor & operator =(const SQLAsyncExecutor &) = delete;
+
+	~SQLAsyncExecutor();
+
+	void Post(Task task);
+
+	template <typename F>
+	auto Submit(F && f) -> std::future<typename std::invoke_result<F, SQLiteWrapper &>::type>;
+
+	template <typename... Args>
+	std::future<void> Execute(const std::string & sql, Args &&... args);
+
+	template <typename T, typename... Args>
+	std::future<std::vector<T>> Select(const std::string & sql, Args &&... args);
+
+	template <typename T, typename Callback, typename... Args>
+	void SelectAsync(const std::string & sql, Callback && callback, Args &&... args);
+
+#ifdef SQL_HAS_COROUTINES
+	//defined in SQLAsyncRows.h
+	//coroutine is resumed on the worker thread unless SetResumer is used - do not block on other tasks there
+	template <typename T, typename... Args>
+	SQLAsyncRows<T> QueryAsync(const std::string & sql, Args &&... args);
+#endif
+
+	void WaitForAll();
+
+protected:
+	typedef struct Node
+	{
+		std::atomic<Node *> next;
+		Task task;
+	} Node;
+
+	//arguments are stored until the task runs - pointers to text are copied
+	template <typename T>
+	struct ArgStorage
+	{
+		typedef typename std::decay<T>::type type;
+	};
+
+	std::shared_ptr<SQLiteWrapper> wrapper;
+
+	//Vyukov MPSC queue, head is written by producers, tail is owned by the worker
+	std::atomic<Node *> head;
+	Node * tail;
+
+	std::atomic<bool> sleeping;
+	std::atomic<bool> stopRequested;
+	std::mutex m;
+	std::condition_variable cv;
+
+	std::thread worker;
+
+	void Enqueue(Task && task);
+	bool Dequeue(Task & task);
+	bool IsEmpty() const;
+
+	void Run();
+};
+
+template <> struct SQLAsyncExecutor::ArgStorage<const char *> { typedef std::string type; };
+template <> struct SQLAsyncExecutor::ArgStorage<char *> { typedef std::string type; };
+template <> struct SQLAsyncExecutor::ArgStorage<std::string_view> { typedef std::string type; };
+
+//===============================================================================
+
+/// <summary>
+/// Run f(SQLiteWrapper &) on the worker thread. 
+/// Returned value (or thrown exception) is passed via future
+/// </summary>
+template <typename F>
+auto SQLAsyncExecutor::Submit(F && f) -> std::future<typename std::invoke_result<F, SQLiteWrapper &>::type>
+{
+	typedef typename std::invoke_result<F, SQLiteWrapper &>::type R;
+
+	//packaged_task is move-only, std::function requires copyable target
+	auto task = std::make_shared<std::packaged_task<R(SQLiteWrapper &)>>(std::forward<F>(f));
+	std::future<R> res = task->get_future();
+
+	this->Enqueue([task](SQLiteWrapper & db) {
+		(*task)(db);
+	});
+
+	return res;
+}
+
+template <typename... Args>
+std::future<void> SQLAsyncExecutor::Execute(const std::string & sql, Args &&... args)
+{
+	std::tuple<typename ArgStorage<typename std::decay<Args>::type>::type...> values(std::forward<Args>(args)...);
+
+	return this->Submit([sql, values = std::move(values)](SQLiteWrapper & db) {
+		auto q = db.Query(sql);
+		std::apply([&](const auto &... a) { q.Execute(a...); }, values);
+	});
+}
+
+/// <summary>
+/// Run SELECT on the worker thread, rows are decoded to T 
+/// (see SQLResult::As). T must own its data (std::string, not std::string_view)
+/// </summary>
+template <typename T, typename... Args>
+std::future<std::vector<T>> SQLAsyncExecutor::Select(const std::string & sql, Args &&... args)
+{
+	std::tuple<typename ArgStorage<typename std::decay<Args>::type>::type...> values(std::forward<Args>(args)...);
+
+	return this->Submit([sql, values = std::move(values)](SQLiteWrapper & db) {
+		auto q = db.Query(sql);
+		SQLResult res = std::apply([&](const auto &... a) { return q.Select(a...); }, values);
+		return res.As<T>().ToVector();
+	});
+}
+
+/// <summary>
+/// Run SELECT on the worker thread and call callback(std::vector<T>) 
+/// with decoded rows. Callback is called on the worker thread
+/// </summary>
+template <typename T, typename Callback, typename... Args>
+void SQLAsyncExecutor::SelectAsync(const std::string & sql, Callback && callback, Args &&... args)
+{
+	std::tuple<typename ArgStorage<typename std::decay<Args>::type>::type...> values(std::forward<Args>(args)...);
+
+	this->Post([sql, values = std::move(values), callback = std::forward<Callback>(callback)](SQLiteWrapper & db) {
+		auto q = db.Query(sql);
+		SQLResult res = std::apply([&](const auto &... a) { return q.Select(a...); }, values);
+		callback(res.As<T>().ToVector());
+	});
+}
+
+#include "SQLAsyncRows.h"
+
+#endif /* SQLAsyncExecutor_hpp */
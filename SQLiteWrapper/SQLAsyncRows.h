@@ -0,0 +1,211 @@
+#ifndef SQLAsyncRows_hpp
+#define SQLAsyncRows_hpp
+
+#include "SQLAsyncExecutor.h"
+
+#ifdef SQL_HAS_COROUTINES
+
+#include <coroutine>
+#include <optional>
+#include <exception>
+
+/// <summary>
+/// Asynchronous generator of decoded rows created by SQLAsyncExecutor::QueryAsync (C++20).
+/// Every co_await Next() steps the statement up to chunk size rows on the 
+/// executor thread and resumes the awaiting coroutine with the decoded chunk.
+/// 
+/// By default, coroutine is resumed directly on the executor thread. 
+/// Resumer can be set to pass the handle to another event loop instead.
+/// 
+/// WARNING: without a resumer, the code after co_await runs on the executor worker.
+/// Blocking there on another executor task (e.g. exec.Submit(...).get()) deadlocks, 
+/// because the only thread that could run the task is waiting. 
+/// Use co_await / callbacks, or set a resumer to continue on your own thread.
+/// 
+/// T must not contain views (std::string_view, SQLBlobView).
+/// Executor must outlive the generator.
+/// 
+/// Usage:
+/// auto rows = exec.QueryAsync<std::tuple<int64_t, std::string>>("SELECT id, name FROM t WHERE id > ?", 10);
+/// while (auto chunk = co_await rows.Next())
+/// {
+///		for (auto & [id, name] : *chunk) { ... }
+/// }
+/// </summary>
+template <typename T>
+class SQLAsyncRows
+{
+public:
+	typedef std::function<void(std::coroutine_handle<> handle)> Resumer;
+
+protected:
+	typedef struct State
+	{
+		std::function<SQLResult(SQLiteWrapper & db)> open;
+		std::optional<SQLResult> result;
+		std::optional<SQLTypedResult<T>> typed;
+		size_t chunkSize = 256;
+		std::vector<T> chunk;
+		bool done = false;
+		std::exception_ptr error;
+		Resumer resumer;
+	} State;
+
+public:
+	class Awaiter
+	{
+	public:
+		bool await_ready() const noexcept
+		{
+			return state->done;
+		}
+
+		void await_suspend(std::coroutine_handle<> handle)
+		{
+			std::shared_ptr<State> s = state;
+			executor->Post([s, handle](SQLiteWrapper & db) {
+				SQLAsyncRows<T>::Fetch(*s, db);
+				if (s->resumer)
+				{
+					s->resumer(handle);
+				}
+				else
+				{
+					handle.resume();
+				}
+			});
+		}
+
+		/// <summary>
+		/// Get fetched chunk
+		/// </summary>
+		/// <returns>nullptr if there are no more rows</returns>
+		const std::vector<T> * await_resume()
+		{
+			if (state->error)
+			{
+				std::exception_ptr e = state->error;
+				state->error = nullptr;
+				std::rethrow_exception(e);
+			}
+			return (state->chunk.empty()) ? nullptr : &state->chunk;
+		}
+
+		friend class SQLAsyncRows<T>;
+
+	private:
+		SQLAsyncExecutor * executor;
+		std::shared_ptr<State> state;
+
+		Awaiter(SQLAsyncExecutor * executor, std::shared_ptr<State> state) : 
+			executor(executor), state(state)
+		{
+		}
+	};
+
+	SQLAsyncRows(SQLAsyncRows && other) noexcept = default;
+	SQLAsyncRows(const SQLAsyncRows &) = delete;
+	SQLAsyncRows & operator =(const SQLAsyncRows &) = delete;
+
+	~SQLAsyncRows()
+	{
+		if ((state == nullptr) || (state->result.has_value() == false))
+		{
+			return;
+		}
+
+		//not finished - statement must be released on the executor thread
+		std::shared_ptr<State> s = std::move(state);
+		executor->Post([s](SQLiteWrapper &) {
+			s->typed.reset();
+			s->result.reset();
+		});
+	}
+
+	Awaiter Next()
+	{
+		if (state->done)
+		{
+			state->chunk.clear();
+		}
+		return Awaiter(executor, state);
+	}
+
+	void SetChunkSize(size_t chunkSize)
+	{
+		state->chunkSize = (chunkSize > 0) ? chunkSize : 1;
+	}
+
+	void SetResumer(Resumer resumer)
+	{
+		state->resumer = std::move(resumer);
+	}
+
+	friend class SQLAsyncExecutor;
+
+protected:
+	SQLAsyncExecutor * executor;
+	std::shared_ptr<State> state;
+
+	SQLAsyncRows(SQLAsyncExecutor * executor, std::function<SQLResult(SQLiteWrapper & db)> open) :
+		executor(executor),
+		state(std::make_shared<State>())
+	{
+		state->open = std::move(open);
+	}
+
+	/// <summary>
+	/// Step statement and decode up to chunkSize rows. Called on the executor thread
+	/// </summary>
+	static void Fetch(State & s, SQLiteWrapper & db)
+	{
+		s.chunk.clear();
+		try
+		{
+			if (s.result.has_value() == false)
+			{
+				s.result.emplace(s.open(db));
+				s.typed.emplace(s.result->template As<T>());
+			}
+
+			while (s.chunk.size() < s.chunkSize)
+			{
+				T * v = s.typed->Next();
+				if (v == nullptr)
+				{
+					s.done = true;
+					break;
+				}
+				s.chunk.push_back(std::move(*v));
+			}
+		}
+		catch (...)
+		{
+			s.error = std::current_exception();
+			s.done = true;
+		}
+
+		if (s.done)
+		{
+			s.typed.reset();
+			s.result.reset();
+		}
+	}
+};
+
+//===============================================================================
+
+template <typename T, typename... Args>
+SQLAsyncRows<T> SQLAsyncExecutor::QueryAsync(const std::string & sql, Args &&... args)
+{
+	std::tuple<typename ArgStorage<typename std::decay<Args>::type>::type...> values(std::forward<Args>(args)...);
+
+	return SQLAsyncRows<T>(this, [sql, values = std::move(values)](SQLiteWrapper & db) {
+		auto q = db.Query(sql);
+		return std::apply([&](const auto &... a) { return q.Select(a...); }, values);
+	});
+}
+
+#endif /* SQL_HAS_COROUTINES */
+
+#endif /* SQLAsyncRows_hpp */
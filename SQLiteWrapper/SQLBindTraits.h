@@ -0,0 +1,147 @@
+#ifndef SQLBindTraits_hpp
+#define SQLBindTraits_hpp
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <chrono>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+
+#include "sqlite3.h"
+
+#include "SQLQuery.h"
+#include "SQLBindValues.h"
+
+/// <summary>
+/// Compile-time selection of the binder for a parameter type.
+/// Used by SQLQuery::Select / Execute / Bind for every argument (after std::decay).
+/// 
+/// Unsupported type is a compile error. Custom types can be added by specialization,
+/// binder may reuse the existing ones or call sqlite3_bind_* directly:
+/// template <> struct SQLBindTraits<Uuid> 
+/// { 
+///		static void Bind(sqlite3_stmt * stmt, int index, const Uuid & value) 
+///		{ 
+///			SQLBindTraits<SQLStaticBlob>::Bind(stmt, index, SQLStatic(value.bytes, 16)); 
+///		} 
+/// };
+/// </summary>
+template <typename T, typename Enable>
+struct SQLBindTraits
+{
+	static_assert(sizeof(T) == 0, "SQLBindTraits: unsupported parameter type");
+};
+
+/// <summary>
+/// Types with own SQLQuery::set overload
+/// </summary>
+struct SQLBindBuiltin
+{
+	template <typename U>
+	static void Bind(sqlite3_stmt * stmt, int index, U && value)
+	{
+		SQLQuery::set(stmt, index, std::forward<U>(value));
+	}
+};
+
+template <> struct SQLBindTraits<std::nullptr_t> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<std::string> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<std::string_view> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<const char *> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<char *> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<std::vector<uint8_t>> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<SQLBlobView> : public SQLBindBuiltin {};
+#ifdef __cpp_lib_span
+template <> struct SQLBindTraits<std::span<const uint8_t>> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<std::span<uint8_t>> : public SQLBindBuiltin {};
+#endif
+template <> struct SQLBindTraits<SQLZeroBlob> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<SQLStaticText> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<SQLStaticBlob> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<SQLOwnedText> : public SQLBindBuiltin {};
+template <> struct SQLBindTraits<SQLOwnedBlob> : public SQLBindBuiltin {};
+
+/// <summary>
+/// Integral value of any width (and bool) is bound as INTEGER. 
+/// Values that fit into int are bound via sqlite3_bind_int, others via sqlite3_bind_int64.
+/// uint64_t over INT64_MAX is stored as negative number (same bits)
+/// </summary>
+template <typename T>
+struct SQLBindTraits<T, typename std::enable_if<std::is_integral<T>::value>::type>
+{
+	static void Bind(sqlite3_stmt * stmt, int index, T value)
+	{
+		if constexpr (std::is_same<T, bool>::value)
+		{
+			SQLQuery::set(stmt, index, static_cast<int>(value ? 1 : 0));
+		}
+		else if constexpr ((sizeof(T) < sizeof(int)) || ((sizeof(T) == sizeof(int)) && std::is_signed<T>::value))
+		{
+			SQLQuery::set(stmt, index, static_cast<int>(value));
+		}
+		else
+		{
+			SQLQuery::set(stmt, index, static_cast<sqlite3_int64>(value));
+		}
+	}
+};
+
+template <typename T>
+struct SQLBindTraits<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+	static void Bind(sqlite3_stmt * stmt, int index, T value)
+	{
+		SQLQuery::set(stmt, index, static_cast<double>(value));
+	}
+};
+
+/// <summary>
+/// Enum is bound as its underlying integer type
+/// </summary>
+template <typename T>
+struct SQLBindTraits<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+	typedef typename std::underlying_type<T>::type U;
+
+	static void Bind(sqlite3_stmt * stmt, int index, T value)
+	{
+		SQLBindTraits<U>::Bind(stmt, index, static_cast<U>(value));
+	}
+};
+
+/// <summary>
+/// Value or NULL if optional is empty
+/// </summary>
+template <typename T>
+struct SQLBindTraits<std::optional<T>>
+{
+	template <typename U>
+	static void Bind(sqlite3_stmt * stmt, int index, U && value)
+	{
+		if (value.has_value())
+		{
+			SQLQuery::setValue(stmt, index, *std::forward<U>(value));
+		}
+		else
+		{
+			SQLQuery::set(stmt, index, nullptr);
+		}
+	}
+};
+
+/// <summary>
+/// Duration is bound as count of its own units (e.g. std::chrono::milliseconds as ms)
+/// </summary>
+template <typename Rep, typename Period>
+struct SQLBindTraits<std::chrono::duration<Rep, Period>>
+{
+	static void Bind(sqlite3_stmt * stmt, int index, const std::chrono::duration<Rep, Period> & value)
+	{
+		SQLBindTraits<Rep>::Bind(stmt, index, value.count());
+	}
+};
+
+#endif /* SQLBindTraits_hpp */
@@ -0,0 +1,115 @@
+#ifndef SQLBindValues_hpp
+#define SQLBindValues_hpp
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#if __has_include(<version>)
+#	include <version>
+#endif
+
+#ifdef __cpp_lib_span
+#	include <span>
+#endif
+
+/// <summary>
+/// Non-owning view of blob data. 
+/// When obtained from SQLRow::RowValue::as_blob_view, it is valid 
+/// until the next step / reset of the statement.
+/// When bound, data are copied by SQLite (SQLITE_TRANSIENT).
+/// </summary>
+struct SQLBlobView
+{
+	const uint8_t * data;
+	size_t size;
+
+	const uint8_t * begin() const { return data; }
+	const uint8_t * end() const { return data + size; }
+	bool empty() const { return size == 0; }
+
+	std::vector<uint8_t> to_vector() const { return std::vector<uint8_t>(begin(), end()); }
+};
+
+inline SQLBlobView SQLBlob(const void * data, size_t size)
+{
+	return { static_cast<const uint8_t *>(data), size };
+}
+
+inline SQLBlobView SQLBlob(const std::vector<uint8_t> & data)
+{
+	return { data.data(), data.size() };
+}
+
+/// <summary>
+/// Helper types for binding of text / blob values without copying.
+/// 
+/// SQLStaticText / SQLStaticBlob are bound with SQLITE_STATIC - SQLite does not
+/// copy the data. Caller must guarantee that data are alive and unchanged 
+/// until the statement is stepped (executed), reset or rebound.
+/// 
+/// SQLOwnedText / SQLOwnedBlob move the buffer into SQLite. SQLite releases it 
+/// once it is no longer needed. They have to be bound as rvalues (std::move).
+/// </summary>
+
+struct SQLStaticText
+{
+	const char * data;
+	size_t length;
+};
+
+struct SQLStaticBlob
+{
+	const void * data;
+	size_t size;
+};
+
+struct SQLOwnedText
+{
+	std::unique_ptr<char[]> data;
+	size_t length;
+};
+
+struct SQLOwnedBlob
+{
+	std::unique_ptr<uint8_t[]> data;
+	size_t size;
+};
+
+/// <summary>
+/// Zero-filled blob of given size (sqlite3_bind_zeroblob64).
+/// Used to preallocate blob that is later written by SQLBlobStream
+/// </summary>
+struct SQLZeroBlob
+{
+	uint64_t size;
+};
+
+inline SQLStaticText SQLStatic(std::string_view value)
+{
+	return { value.data(), value.length() };
+}
+
+inline SQLStaticBlob SQLStatic(const void * data, size_t size)
+{
+	return { data, size };
+}
+
+inline SQLStaticBlob SQLStatic(SQLBlobView value)
+{
+	return { value.data, value.size };
+}
+
+inline SQLOwnedText SQLOwned(std::unique_ptr<char[]> data, size_t length)
+{
+	return { std::move(data), length };
+}
+
+inline SQLOwnedBlob SQLOwned(std::unique_ptr<uint8_t[]> data, size_t size)
+{
+	return { std::move(data), size };
+}
+
+#endif /* SQLBindValues_hpp */
@@ -0,0 +1,156 @@
+#include "SQLBlobStream.h"
+
+#include <algorithm>
+
+#include "SQLiteWrapper.h"
+
+SQLBlobStream::SQLBlobStream(std::shared_ptr<SQLiteWrapper> wrapper, sqlite3_blob * blob, bool writable) :
+	wrapper(wrapper),
+	blob(blob),
+	writable(writable),
+	position(0)
+{
+}
+
+SQLBlobStream::~SQLBlobStream()
+{
+	SQLITE_CHECK(sqlite3_blob_close(blob));
+}
+
+int SQLBlobStream::GetSize() const
+{
+	return sqlite3_blob_bytes(blob);
+}
+
+bool SQLBlobStream::IsWritable() const
+{
+	return writable;
+}
+
+int SQLBlobStream::GetPosition() const
+{
+	return position;
+}
+
+/// <summary>
+/// Set position for sequential Read / Write
+/// </summary>
+/// <param name="offset"></param>
+void SQLBlobStream::Seek(int offset)
+{
+	position = std::max(0, std::min(offset, this->GetSize()));
+}
+
+/// <summary>
+/// Read length bytes starting at offset.
+/// Throws SQLException, if the range is outside of the blob or the stream is expired
+/// </summary>
+/// <param name="buffer"></param>
+/// <param name="length"></param>
+/// <param name="offset"></param>
+void SQLBlobStream::Read(void * buffer, int length, int offset)
+{
+	int r = sqlite3_blob_read(blob, buffer, length, offset);
+	if (r != SQLITE_OK)
+	{
+		SQLException::Throw(r, wrapper->GetRawConnection(), "sqlite3_blob_read");
+	}
+}
+
+/// <summary>
+/// Write length bytes starting at offset.
+/// Blob can not be resized - throws SQLException, if the range is outside of the blob,
+/// the stream is expired or the database is busy
+/// </summary>
+/// <param name="data"></param>
+/// <param name="length"></param>
+/// <param name="offset"></param>
+void SQLBlobStream::Write(const void * data, int length, int offset)
+{
+	int r = sqlite3_blob_write(blob, data, length, offset);
+	if (r != SQLITE_OK)
+	{
+		SQLException::Throw(r, wrapper->GetRawConnection(), "sqlite3_blob_write");
+	}
+}
+
+/// <summary>
+/// Read up to length bytes from the current position
+/// </summary>
+/// <param name="buffer"></param>
+/// <param name="length"></param>
+/// <returns>number of read bytes, 0 at the end</returns>
+int SQLBlobStream::Read(void * buffer, int length)
+{
+	int toRead = std::min(length, this->GetSize() - position);
+	if (toRead <= 0)
+	{
+		return 0;
+	}
+
+	this->Read(buffer, toRead, position);
+	position += toRead;
+	return toRead;
+}
+
+/// <summary>
+/// Write data at the current position
+/// </summary>
+/// <param name="data"></param>
+/// <param name="length"></param>
+void SQLBlobStream::Write(const void * data, int length)
+{
+	this->Write(data, length, position);
+	position += length;
+}
+
+/// <summary>
+/// Read the whole blob in chunks of chunkSize bytes. 
+/// Chunk is passed to callback and it is valid only during the callback.
+/// If callback returns false, reading is stopped.
+/// </summary>
+/// <param name="chunkSize"></param>
+/// <param name="callback"></param>
+/// <returns>number of read bytes (0 if chunkSize is not positive)</returns>
+size_t SQLBlobStream::ReadChunks(int chunkSize, 
+	const std::function<bool(const uint8_t * data, int length)> & callback)
+{
+	if (chunkSize <= 0)
+	{
+		return 0;
+	}
+
+	int size = this->GetSize();
+	std::vector<uint8_t> buffer(static_cast<size_t>(std::max(1, std::min(chunkSize, size))));
+
+	size_t total = 0;
+	for (int offset = 0; offset < size; offset += chunkSize)
+	{
+		int len = std::min(chunkSize, size - offset);
+		this->Read(buffer.data(), len, offset);
+		total += len;
+
+		if (callback(buffer.data(), len) == false)
+		{
+			break;
+		}
+	}
+
+	return total;
+}
+
+/// <summary>
+/// Move stream to the same column of another row. 
+/// Faster than opening a new stream.
+/// Throws SQLException if the row does not exist (stream can not be used after that)
+/// </summary>
+/// <param name="rowId"></param>
+void SQLBlobStream::Reopen(sqlite3_int64 rowId)
+{
+	int r = sqlite3_blob_reopen(blob, rowId);
+	if (r != SQLITE_OK)
+	{
+		SQLException::Throw(r, wrapper->GetRawConnection(), "sqlite3_blob_reopen");
+	}
+	position = 0;
+}
@@ -0,0 +1,59 @@
+#ifndef SQLBlobStream_hpp
+#define SQLBlobStream_hpp
+
+#include <memory>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+#include "sqlite3.h"
+
+class SQLiteWrapper;
+
+/// <summary>
+/// Incremental I/O of a single blob (sqlite3_blob_*).
+/// Opened by SQLiteWrapper::OpenBlob for given table, column and rowid.
+/// 
+/// Blob size can not be changed via the stream. To write a new blob, insert 
+/// zero-filled blob of the final size first (bind SQLZeroBlob) and then write it in chunks.
+/// 
+/// If the row is modified by other statement, stream is expired and 
+/// all reads / writes fail. Reopen can be used to move stream to another row.
+/// Failed operations throw SQLException
+/// </summary>
+class SQLBlobStream
+{
+public:
+	SQLBlobStream(const SQLBlobStream &) = delete;
+	SQLBlobStream & operator =(const SQLBlobStream &) = delete;
+
+	~SQLBlobStream();
+
+	int GetSize() const;
+	bool IsWritable() const;
+
+	int GetPosition() const;
+	void Seek(int offset);
+
+	void Read(void * buffer, int length, int offset);
+	void Write(const void * data, int length, int offset);
+
+	int Read(void * buffer, int length);
+	void Write(const void * data, int length);
+
+	size_t ReadChunks(int chunkSize, const std::function<bool(const uint8_t * data, int length)> & callback);
+
+	void Reopen(sqlite3_int64 rowId);
+
+	friend class SQLiteWrapper;
+
+protected:
+	std::shared_ptr<SQLiteWrapper> wrapper;
+	sqlite3_blob * blob;
+	bool writable;
+	int position;
+
+	SQLBlobStream(std::shared_ptr<SQLiteWrapper> wrapper, sqlite3_blob * blob, bool writable);
+};
+
+#endif /* SQLBlobStream_hpp */
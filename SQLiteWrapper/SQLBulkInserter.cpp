@@ -0,0 +1,69 @@
+#include "SQLBulkInserter.h"
+
+#include <algorithm>
+
+SQLBulkInserter::SQLBulkInserter(std::shared_ptr<SQLiteWrapper> wrapper,
+	const std::string & tableName,
+	const std::vector<std::string> & columns,
+	int rowsPerStatement,
+	size_t rowsPerTransaction) :
+	wrapper(wrapper),
+	columnsCount(columns.size()),
+	rowsPerStatement(1),
+	rowsPerTransaction(rowsPerTransaction)
+{
+	//number of bound parameters in one statement is limited
+	int maxVariables = sqlite3_limit(wrapper->GetRawConnection(), SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+	int maxRows = std::max(1, maxVariables / std::max(1, static_cast<int>(columnsCount)));
+	
+	this->rowsPerStatement = std::max(1, std::min(rowsPerStatement, maxRows));
+
+	this->singleQuery = wrapper->Query(CreateInsertSQL(tableName, columns, 1));
+	if (this->rowsPerStatement > 1)
+	{
+		this->multiQuery = wrapper->Query(CreateInsertSQL(tableName, columns, this->rowsPerStatement));
+	}
+}
+
+int SQLBulkInserter::GetRowsPerStatement() const
+{
+	return rowsPerStatement;
+}
+
+/// <summary>
+/// Create INSERT INTO table (c1, c2) VALUES (?,?),(?,?)...
+/// </summary>
+/// <param name="tableName"></param>
+/// <param name="columns"></param>
+/// <param name="rowsCount"></param>
+/// <returns></returns>
+std::string SQLBulkInserter::CreateInsertSQL(const std::string & tableName,
+	const std::vector<std::string> & columns, int rowsCount)
+{
+	std::string q = "INSERT INTO " + tableName + " (";
+	for (auto & c : columns)
+	{
+		q += c;
+		q += ",";
+	}
+	q.pop_back();
+	q += ") VALUES ";
+
+	std::string values = "(";
+	for (size_t i = 0; i < columns.size(); i++)
+	{
+		values += "?,";
+	}
+	values.pop_back();
+	values += ")";
+
+	q.reserve(q.length() + rowsCount * (values.length() + 1));
+	for (int i = 0; i < rowsCount; i++)
+	{
+		q += values;
+		q += ",";
+	}
+	q.pop_back();
+
+	return q;
+}
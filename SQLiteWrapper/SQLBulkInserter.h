@@ -0,0 +1,157 @@
+#ifndef SQLBulkInserter_hpp
+#define SQLBulkInserter_hpp
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <iterator>
+
+#include "sqlite3.h"
+
+#include "SQLQuery.h"
+#include "SQLTable.h"
+#include "SQLiteWrapper.h"
+
+/// <summary>
+/// Insert many rows into a table with a single prepared statement.
+/// Each row is a tuple (or anything that can be projected to a tuple,
+/// e.g. struct via [](const Item & i) { return std::tie(i.a, i.b); }).
+/// 
+/// Rows can be packed into multi-row statements INSERT ... VALUES (?,?),(?,?)...
+/// Number of rows per statement is limited by SQLITE_LIMIT_VARIABLE_NUMBER.
+/// All rows are inserted in a transaction (or savepoint, if there is an active one), 
+/// optionally commited after every rowsPerTransaction rows.
+/// 
+/// Usage:
+/// SQLBulkInserter ins(db, "table", { "a", "b" }, 64);
+/// ins.Insert(std::vector<std::tuple<int, std::string>>{ ... });
+/// </summary>
+class SQLBulkInserter
+{
+public:
+	SQLBulkInserter(std::shared_ptr<SQLiteWrapper> wrapper, 
+		const std::string & tableName,
+		const std::vector<std::string> & columns,
+		int rowsPerStatement = 1,
+		size_t rowsPerTransaction = 0);
+	~SQLBulkInserter() = default;
+
+	int GetRowsPerStatement() const;
+
+	template <typename Range>
+	size_t Insert(const Range & rows);
+
+	template <typename Range, typename Projection>
+	size_t Insert(const Range & rows, Projection proj);
+
+	static std::string CreateInsertSQL(const std::string & tableName,
+		const std::vector<std::string> & columns, int rowsCount);
+
+protected:
+	std::shared_ptr<SQLiteWrapper> wrapper;
+	size_t columnsCount;
+	int rowsPerStatement;
+	size_t rowsPerTransaction;
+
+	SQLQuery singleQuery;
+	SQLQuery multiQuery;
+
+	template <typename Tuple, size_t... I>
+	void BindTuple(SQLQuery & q, int index, const Tuple & t, std::index_sequence<I...>)
+	{
+		int dummy[] = { 0, (SQLQuery::setValue(q.stmt.get(), index + static_cast<int>(I), std::get<I>(t)), 0)... };
+		(void)dummy;
+	}
+
+	template <typename Tuple>
+	void BindTuple(SQLQuery & q, int index, const Tuple & t)
+	{
+		this->BindTuple(q, index, t, std::make_index_sequence<std::tuple_size<Tuple>::value>());
+	}
+};
+
+//===============================================================================
+
+template <typename Range>
+size_t SQLBulkInserter::Insert(const Range & rows)
+{
+	return this->Insert(rows, [](const auto & r) -> const auto & { return r; });
+}
+
+template <typename Range, typename Projection>
+size_t SQLBulkInserter::Insert(const Range & rows, Projection proj)
+{
+	auto it = std::begin(rows);
+	auto itEnd = std::end(rows);
+
+	size_t count = static_cast<size_t>(std::distance(it, itEnd));
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	size_t rowsPerStmt = static_cast<size_t>(rowsPerStatement);
+	size_t multiCount = (rowsPerStmt > 1) ? (count / rowsPerStmt) * rowsPerStmt : 0;
+
+	auto transaction = wrapper->BeginTransaction(SQLTransaction::Mode::Immediate);
+
+	size_t inserted = 0;
+	size_t transactionRows = 0;
+	while (it != itEnd)
+	{
+		//all parameters are rebound for every row - no need to clear bindings
+		if (inserted < multiCount)
+		{
+			multiQuery.Reset();
+			for (size_t i = 0; i < rowsPerStmt; i++, ++it)
+			{
+				this->BindTuple(multiQuery, static_cast<int>(i * columnsCount) + 1, proj(*it));
+			}
+			multiQuery.ExecuteStep();
+			inserted += rowsPerStmt;
+			transactionRows += rowsPerStmt;
+		}
+		else
+		{
+			singleQuery.Reset();
+			this->BindTuple(singleQuery, 1, proj(*it));
+			singleQuery.ExecuteStep();
+			++it;
+			inserted++;
+			transactionRows++;
+		}
+
+		if ((rowsPerTransaction > 0) && (transactionRows >= rowsPerTransaction) && (it != itEnd))
+		{
+			transaction.Commit();
+			transaction = wrapper->BeginTransaction(SQLTransaction::Mode::Immediate);
+			transactionRows = 0;
+		}
+	}
+
+	transaction.Commit();
+
+	return inserted;
+}
+
+//===============================================================================
+
+template <typename Range>
+size_t SQLTable::InsertRows(const std::vector<std::string> & columns, const Range & rows, 
+	int rowsPerStatement)
+{
+	SQLBulkInserter ins(wrapper, name, columns, rowsPerStatement);
+	return ins.Insert(rows);
+}
+
+template <typename Range, typename Projection>
+size_t SQLTable::InsertRows(const std::vector<std::string> & columns, const Range & rows, 
+	Projection proj, int rowsPerStatement)
+{
+	SQLBulkInserter ins(wrapper, name, columns, rowsPerStatement);
+	return ins.Insert(rows, proj);
+}
+
+#endif /* SQLBulkInserter_hpp */
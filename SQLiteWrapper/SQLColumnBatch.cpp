@@ -0,0 +1,169 @@
+#include "SQLColumnBatch.h"
+
+#include <cstring>
+#include <cctype>
+
+size_t SQLColumnBatch::GetRowsCount() const
+{
+	return rowsCount;
+}
+
+size_t SQLColumnBatch::GetColumnsCount() const
+{
+	return columns.size();
+}
+
+const SQLColumnBatch::Column & SQLColumnBatch::operator [](size_t index) const
+{
+	return columns[index];
+}
+
+const SQLColumnBatch::Column & SQLColumnBatch::at(size_t index) const
+{
+	return columns.at(index);
+}
+
+/// <summary>
+/// Prepare columns for up to capacity rows
+/// </summary>
+/// <param name="stmt"></param>
+/// <param name="types"></param>
+/// <param name="capacity"></param>
+void SQLColumnBatch::Init(sqlite3_stmt * stmt, const std::vector<SQLEnums::ValueDataType> & types, 
+	size_t capacity)
+{
+	rowsCount = 0;
+	columns.clear();
+	columns.resize(types.size());
+
+	for (size_t i = 0; i < types.size(); i++)
+	{
+		Column & c = columns[i];
+		c.name = sqlite3_column_name(stmt, static_cast<int>(i));
+		c.type = types[i];
+		c.nulls.reserve((capacity + 63) / 64);
+
+		switch (c.type)
+		{
+		case SQLEnums::ValueDataType::Integer: c.integers.reserve(capacity); break;
+		case SQLEnums::ValueDataType::Float: c.floats.reserve(capacity); break;
+		default:
+			c.offsets.reserve(capacity + 1);
+			c.offsets.push_back(0);
+			break;
+		}
+	}
+}
+
+/// <summary>
+/// Decode current row of the statement into columns
+/// </summary>
+/// <param name="stmt"></param>
+void SQLColumnBatch::AppendRow(sqlite3_stmt * stmt)
+{
+	size_t row = rowsCount;
+	for (size_t i = 0; i < columns.size(); i++)
+	{
+		Column & c = columns[i];
+		int ci = static_cast<int>(i);
+
+		if ((row & 63) == 0)
+		{
+			c.nulls.push_back(0);
+		}
+
+		bool isNull = (sqlite3_column_type(stmt, ci) == SQLITE_NULL);
+		if (isNull)
+		{
+			c.nulls.back() |= (uint64_t(1) << (row & 63));
+		}
+
+		switch (c.type)
+		{
+		case SQLEnums::ValueDataType::Integer:
+			c.integers.push_back(sqlite3_column_int64(stmt, ci));
+			break;
+		case SQLEnums::ValueDataType::Float:
+			c.floats.push_back(sqlite3_column_double(stmt, ci));
+			break;
+		default:
+		{
+			//sqlite3_column_text / blob must be called before sqlite3_column_bytes
+			const void * data = (c.type == SQLEnums::ValueDataType::Blob) ?
+				sqlite3_column_blob(stmt, ci) : 
+				static_cast<const void *>(sqlite3_column_text(stmt, ci));
+			size_t len = static_cast<size_t>(sqlite3_column_bytes(stmt, ci));
+
+			if (len > 0)
+			{
+				size_t start = c.bytes.size();
+				c.bytes.resize(start + len);
+				memcpy(c.bytes.data() + start, data, len);
+			}
+			c.offsets.push_back(c.bytes.size());
+			break;
+		}
+		}
+	}
+	rowsCount++;
+}
+
+/// <summary>
+/// Get type based on declared column type (SQLite affinity rules).
+/// Expressions do not have declared type - Null is returned
+/// </summary>
+/// <param name="stmt"></param>
+/// <param name="column"></param>
+/// <returns></returns>
+SQLEnums::ValueDataType SQLColumnBatch::GetDeclaredType(sqlite3_stmt * stmt, int column)
+{
+	const char * declType = sqlite3_column_decltype(stmt, column);
+	if (declType == nullptr)
+	{
+		return SQLEnums::ValueDataType::Null;
+	}
+
+	std::string t = declType;
+	for (auto & c : t)
+	{
+		c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+	}
+
+	if (t.find("INT") != std::string::npos) return SQLEnums::ValueDataType::Integer;
+	if ((t.find("CHAR") != std::string::npos) || (t.find("CLOB") != std::string::npos) ||
+		(t.find("TEXT") != std::string::npos)) return SQLEnums::ValueDataType::String;
+	if ((t.empty()) || (t.find("BLOB") != std::string::npos)) return SQLEnums::ValueDataType::Blob;
+	
+	return SQLEnums::ValueDataType::Float;
+}
+
+/// <summary>
+/// Infer column types from values of the current row.
+/// NULL values use declared column type, if there is none, String is used
+/// </summary>
+/// <param name="stmt"></param>
+/// <returns></returns>
+std::vector<SQLEnums::ValueDataType> SQLColumnBatch::InferTypes(sqlite3_stmt * stmt)
+{
+	int count = sqlite3_column_count(stmt);
+
+	std::vector<SQLEnums::ValueDataType> types;
+	types.reserve(count);
+	for (int i = 0; i < count; i++)
+	{
+		switch (sqlite3_column_type(stmt, i))
+		{
+		case SQLITE_INTEGER: types.push_back(SQLEnums::ValueDataType::Integer); break;
+		case SQLITE_FLOAT: types.push_back(SQLEnums::ValueDataType::Float); break;
+		case SQLITE_TEXT: types.push_back(SQLEnums::ValueDataType::String); break;
+		case SQLITE_BLOB: types.push_back(SQLEnums::ValueDataType::Blob); break;
+		default:
+		{
+			SQLEnums::ValueDataType t = GetDeclaredType(stmt, i);
+			types.push_back((t == SQLEnums::ValueDataType::Null) ? SQLEnums::ValueDataType::String : t);
+			break;
+		}
+		}
+	}
+	return types;
+}
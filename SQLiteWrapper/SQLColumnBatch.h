@@ -0,0 +1,92 @@
+#ifndef SQLColumnBatch_hpp
+#define SQLColumnBatch_hpp
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "sqlite3.h"
+
+#include "SQLEnums.h"
+#include "SQLBindValues.h"
+
+/// <summary>
+/// Columnar batch of rows created by SQLResult::FetchColumns.
+/// Every column has a single type for the whole batch and its values 
+/// are stored contiguously:
+///  - Integer: std::vector<int64_t>
+///  - Float: std::vector<double>
+///  - String / Blob: offsets + bytes arena (value i is bytes[offsets[i], offsets[i + 1]))
+/// NULL values are marked in null bitmap (bit set = NULL), 
+/// numeric NULLs are stored as 0, string / blob NULLs as empty values.
+/// 
+/// Batch owns its data, it is valid also after the result is stepped further.
+/// </summary>
+class SQLColumnBatch
+{
+public:
+	class Column
+	{
+	public:
+		const std::string & GetName() const { return name; }
+		SQLEnums::ValueDataType GetType() const { return type; }
+
+		const std::vector<int64_t> & GetIntegers() const { return integers; }
+		const std::vector<double> & GetFloats() const { return floats; }
+		const std::vector<uint64_t> & GetOffsets() const { return offsets; }
+		const std::vector<char> & GetBytes() const { return bytes; }
+		const std::vector<uint64_t> & GetNullBitmap() const { return nulls; }
+
+		bool IsNull(size_t row) const 
+		{ 
+			return (nulls[row >> 6] >> (row & 63)) & 1; 
+		}
+
+		std::string_view GetString(size_t row) const
+		{
+			return std::string_view(bytes.data() + offsets[row], 
+				static_cast<size_t>(offsets[row + 1] - offsets[row]));
+		}
+
+		SQLBlobView GetBlob(size_t row) const
+		{
+			return SQLBlob(bytes.data() + offsets[row], 
+				static_cast<size_t>(offsets[row + 1] - offsets[row]));
+		}
+
+		friend class SQLColumnBatch;
+
+	private:
+		std::string name;
+		SQLEnums::ValueDataType type;
+
+		std::vector<int64_t> integers;
+		std::vector<double> floats;
+		std::vector<uint64_t> offsets;
+		std::vector<char> bytes;
+		std::vector<uint64_t> nulls;
+	};
+
+	SQLColumnBatch() = default;
+
+	size_t GetRowsCount() const;
+	size_t GetColumnsCount() const;
+
+	const Column & operator [](size_t index) const;
+	const Column & at(size_t index) const;
+
+	friend class SQLResult;
+
+private:
+	size_t rowsCount = 0;
+	std::vector<Column> columns;
+
+	void Init(sqlite3_stmt * stmt, const std::vector<SQLEnums::ValueDataType> & types, size_t capacity);
+	void AppendRow(sqlite3_stmt * stmt);
+
+	static SQLEnums::ValueDataType GetDeclaredType(sqlite3_stmt * stmt, int column);
+	static std::vector<SQLEnums::ValueDataType> InferTypes(sqlite3_stmt * stmt);
+};
+
+#endif /* SQLColumnBatch_hpp */
@@ -0,0 +1,197 @@
+#ifndef SQLColumnTraits_hpp
+#define SQLColumnTraits_hpp
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+
+#include "sqlite3.h"
+
+#include "SQLBindValues.h"
+
+/// <summary>
+/// Compile-time decoding of a single column value.
+/// Read is resolved at compile time, there is no per-value dispatch.
+/// 
+/// std::string_view and SQLBlobView are valid until the next step / reset 
+/// of the statement.
+/// 
+/// Unsupported type is a compile error. Custom types can be added by specialization:
+/// template <> struct SQLColumnTraits<MyType> 
+/// { 
+///		static MyType Read(sqlite3_stmt * stmt, int column) { ... } 
+/// };
+/// </summary>
+template <typename T, typename Enable = void>
+struct SQLColumnTraits
+{
+	static_assert(sizeof(T) == 0, "SQLColumnTraits: unsupported column type");
+};
+
+template <typename T>
+struct SQLColumnTraits<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type>
+{
+	static T Read(sqlite3_stmt * stmt, int column)
+	{
+		//unsigned int does not fit into int
+		if constexpr ((sizeof(T) < sizeof(int)) || ((sizeof(T) == sizeof(int)) && std::is_signed<T>::value))
+		{
+			return static_cast<T>(sqlite3_column_int(stmt, column));
+		}
+		return static_cast<T>(sqlite3_column_int64(stmt, column));
+	}
+};
+
+template <>
+struct SQLColumnTraits<bool>
+{
+	static bool Read(sqlite3_stmt * stmt, int column)
+	{
+		return sqlite3_column_int(stmt, column) != 0;
+	}
+};
+
+template <typename T>
+struct SQLColumnTraits<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+	static T Read(sqlite3_stmt * stmt, int column)
+	{
+		return static_cast<T>(sqlite3_column_double(stmt, column));
+	}
+};
+
+template <>
+struct SQLColumnTraits<std::string_view>
+{
+	static std::string_view Read(sqlite3_stmt * stmt, int column)
+	{
+		//sqlite3_column_text must be called before sqlite3_column_bytes
+		const char * data = reinterpret_cast<const char *>(sqlite3_column_text(stmt, column));
+		int len = sqlite3_column_bytes(stmt, column);
+		return (data == nullptr) ? std::string_view() : std::string_view(data, static_cast<size_t>(len));
+	}
+};
+
+template <>
+struct SQLColumnTraits<std::string>
+{
+	static std::string Read(sqlite3_stmt * stmt, int column)
+	{
+		return std::string(SQLColumnTraits<std::string_view>::Read(stmt, column));
+	}
+};
+
+template <>
+struct SQLColumnTraits<SQLBlobView>
+{
+	static SQLBlobView Read(sqlite3_stmt * stmt, int column)
+	{
+		//sqlite3_column_blob must be called before sqlite3_column_bytes
+		const uint8_t * data = static_cast<const uint8_t *>(sqlite3_column_blob(stmt, column));
+		int size = sqlite3_column_bytes(stmt, column);
+		return { data, static_cast<size_t>(size) };
+	}
+};
+
+template <>
+struct SQLColumnTraits<std::vector<uint8_t>>
+{
+	static std::vector<uint8_t> Read(sqlite3_stmt * stmt, int column)
+	{
+		return SQLColumnTraits<SQLBlobView>::Read(stmt, column).to_vector();
+	}
+};
+
+template <typename T>
+struct SQLColumnTraits<std::optional<T>>
+{
+	static std::optional<T> Read(sqlite3_stmt * stmt, int column)
+	{
+		if (sqlite3_column_type(stmt, column) == SQLITE_NULL)
+		{
+			return std::nullopt;
+		}
+		return SQLColumnTraits<T>::Read(stmt, column);
+	}
+};
+
+//===============================================================================
+
+/// <summary>
+/// Mapping of struct fields to result columns (in order of columns).
+/// Specialize it with SQL_ROW_MAPPING macro at global scope:
+/// 
+/// struct Person { int64_t id; std::string name; double score; };
+/// SQL_ROW_MAPPING(Person, &Person::id, &Person::name, &Person::score)
+/// </summary>
+template <typename T>
+struct SQLRowMapping;
+
+#define SQL_ROW_MAPPING(type, ...) \
+	template <> struct SQLRowMapping<type> { \
+		static constexpr auto Fields() { return std::make_tuple(__VA_ARGS__); } \
+	};
+
+/// <summary>
+/// Decode the whole row into a std::tuple or a mapped struct.
+/// Column i is decoded into i-th tuple element / mapped field.
+/// </summary>
+template <typename T>
+struct SQLRowDecoder
+{
+	static constexpr int ColumnsCount()
+	{
+		return static_cast<int>(std::tuple_size<decltype(SQLRowMapping<T>::Fields())>::value);
+	}
+
+	static T Decode(sqlite3_stmt * stmt)
+	{
+		T obj;
+		DecodeFields(stmt, obj, SQLRowMapping<T>::Fields(),
+			std::make_index_sequence<std::tuple_size<decltype(SQLRowMapping<T>::Fields())>::value>());
+		return obj;
+	}
+
+private:
+	template <typename Obj, typename Field>
+	static void DecodeField(sqlite3_stmt * stmt, int column, Obj & obj, Field field)
+	{
+		typedef typename std::decay<decltype(obj.*field)>::type FieldType;
+		obj.*field = SQLColumnTraits<FieldType>::Read(stmt, column);
+	}
+
+	template <typename Fields, size_t... I>
+	static void DecodeFields(sqlite3_stmt * stmt, T & obj, const Fields & fields, std::index_sequence<I...>)
+	{
+		int dummy[] = { 0, (DecodeField(stmt, static_cast<int>(I), obj, std::get<I>(fields)), 0)... };
+		(void)dummy;
+	}
+};
+
+template <typename... Ts>
+struct SQLRowDecoder<std::tuple<Ts...>>
+{
+	static constexpr int ColumnsCount()
+	{
+		return static_cast<int>(sizeof...(Ts));
+	}
+
+	static std::tuple<Ts...> Decode(sqlite3_stmt * stmt)
+	{
+		return Decode(stmt, std::index_sequence_for<Ts...>());
+	}
+
+private:
+	template <size_t... I>
+	static std::tuple<Ts...> Decode(sqlite3_stmt * stmt, std::index_sequence<I...>)
+	{
+		return std::tuple<Ts...>{ SQLColumnTraits<Ts>::Read(stmt, static_cast<int>(I))... };
+	}
+};
+
+#endif /* SQLColumnTraits_hpp */
@@ -0,0 +1,52 @@
+#include "SQLConnectionOptions.h"
+
+#include "SQLiteWrapper.h"
+
+SQLConnectionOptions SQLConnectionOptions::BulkLoad()
+{
+	SQLConnectionOptions o;
+	o.journalMode = JournalMode::WAL;
+	o.synchronous = Synchronous::Off;
+	o.cacheSize = -256 * 1024;
+	o.tempStore = TempStore::Memory;
+	o.lockingMode = LockingMode::Exclusive;
+	o.walAutoCheckpoint = 10000;
+	return o;
+}
+
+SQLConnectionOptions SQLConnectionOptions::ReadMostly()
+{
+	SQLConnectionOptions o;
+	o.journalMode = JournalMode::WAL;
+	o.synchronous = Synchronous::Normal;
+	o.cacheSize = -64 * 1024;
+	o.mmapSize = 256LL * 1024 * 1024;
+	o.tempStore = TempStore::Memory;
+	o.busyTimeout = 5000;
+	return o;
+}
+
+SQLConnectionOptions SQLConnectionOptions::Durable()
+{
+	SQLConnectionOptions o;
+	o.journalMode = JournalMode::WAL;
+	o.synchronous = Synchronous::Full;
+	o.busyTimeout = 5000;
+	o.walAutoCheckpoint = 1000;
+	return o;
+}
+
+/// <summary>
+/// Get options by preset name ("bulk-load", "read-mostly", "durable")
+/// </summary>
+/// <param name="name"></param>
+/// <returns>empty options for unknown name</returns>
+SQLConnectionOptions SQLConnectionOptions::Preset(const std::string & name)
+{
+	if (name == "bulk-load") return BulkLoad();
+	if (name == "read-mostly") return ReadMostly();
+	if (name == "durable") return Durable();
+
+	SQL_LOG("Unknown connection preset: %s\n", name.c_str());
+	return SQLConnectionOptions();
+}
@@ -0,0 +1,67 @@
+#ifndef SQLConnectionOptions_hpp
+#define SQLConnectionOptions_hpp
+
+#include <optional>
+#include <string>
+#include <cstdint>
+
+/// <summary>
+/// Connection tuning applied by SQLiteWrapper::Open right after the database is opened.
+/// Only values that are set are changed, others keep SQLite defaults.
+/// 
+/// Named presets:
+/// "bulk-load"		- fast writes of large amounts of data, no durability, exclusive access
+/// "read-mostly"	- WAL with large page cache and memory mapped I/O for concurrent readers
+/// "durable"		- WAL with full fsync, every commit survives power loss
+/// </summary>
+struct SQLConnectionOptions
+{
+	enum class JournalMode 
+	{
+		Delete,
+		Truncate,
+		Persist,
+		Memory,
+		WAL,
+		Off
+	};
+
+	enum class Synchronous 
+	{
+		Off,
+		Normal,
+		Full,
+		Extra
+	};
+
+	enum class TempStore 
+	{
+		Default,
+		File,
+		Memory
+	};
+
+	enum class LockingMode 
+	{
+		Normal,
+		Exclusive
+	};
+
+	std::optional<JournalMode> journalMode;
+	std::optional<Synchronous> synchronous;
+	std::optional<int> cacheSize;			//pages, negative value is size in KiB
+	std::optional<int64_t> mmapSize;		//bytes, 0 - disabled
+	std::optional<TempStore> tempStore;
+	std::optional<int> pageSize;			//bytes, applied only to a new database
+	std::optional<int> busyTimeout;			//ms
+	std::optional<LockingMode> lockingMode;
+	std::optional<int> walAutoCheckpoint;	//pages, 0 - disabled
+
+	static SQLConnectionOptions BulkLoad();
+	static SQLConnectionOptions ReadMostly();
+	static SQLConnectionOptions Durable();
+
+	static SQLConnectionOptions Preset(const std::string & name);
+};
+
+#endif /* SQLConnectionOptions_hpp */
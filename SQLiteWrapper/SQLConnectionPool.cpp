@@ -0,0 +1,239 @@
+#include "SQLConnectionPool.h"
+
+#include <algorithm>
+
+#include "SQLiteWrapper.h"
+
+static bool IsConnectionOpen(const std::shared_ptr<SQLiteWrapper> & c)
+{
+	sqlite3 * db = c->GetRawConnection();
+	return (db != nullptr) && (sqlite3_errcode(db) == SQLITE_OK);
+}
+
+SQLConnectionPool::SQLConnectionPool() :
+	writerInUse(false),
+	freeReaders(0)
+{
+}
+
+/// <summary>
+/// Open pool for database file. File is created if it does not exist
+/// and switched to WAL journal mode.
+/// </summary>
+/// <param name="path"></param>
+/// <param name="readersCount">number of read-only connections, 0 = number of CPU cores</param>
+/// <param name="busyTimeoutMs">busy timeout set for all connections</param>
+/// <returns>nullptr if writer connection can not be opened or switched to WAL mode</returns>
+std::shared_ptr<SQLConnectionPool> SQLConnectionPool::Open(const std::string & path, 
+	size_t readersCount, int busyTimeoutMs)
+{
+	if (readersCount == 0)
+	{
+		readersCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	std::shared_ptr<SQLConnectionPool> pool = std::shared_ptr<SQLConnectionPool>(new SQLConnectionPool());
+
+	SQLConnectionOptions readerOptions;
+	readerOptions.busyTimeout = busyTimeoutMs;
+
+	//readers opened later must see the database already in WAL mode
+	SQLConnectionOptions writerOptions = readerOptions;
+	writerOptions.journalMode = SQLConnectionOptions::JournalMode::WAL;
+	writerOptions.synchronous = SQLConnectionOptions::Synchronous::Normal;
+
+	pool->writer = SQLiteWrapper::Open(path, 
+		SQLEnums::ReadWrite | SQLEnums::Create | SQLEnums::NoMutex);
+	if (IsConnectionOpen(pool->writer) == false)
+	{
+		return nullptr;
+	}
+
+	//without WAL, readers would block the writer (and vice versa)
+	if (pool->writer->Configure(writerOptions) == false)
+	{
+		SQL_LOG("SQLConnectionPool: WAL mode can not be enabled for %s\n", path.c_str());
+		return nullptr;
+	}
+
+	for (size_t i = 0; i < readersCount; i++)
+	{
+		auto r = SQLiteWrapper::Open(path, SQLEnums::Read | SQLEnums::NoMutex);
+		if (IsConnectionOpen(r) == false)
+		{
+			continue;
+		}
+
+		r->Configure(readerOptions);
+		pool->readers.push_back({ r, std::thread::id(), false });
+	}
+	pool->freeReaders = pool->readers.size();
+
+	return pool;
+}
+
+size_t SQLConnectionPool::GetReadersCount() const
+{
+	return readers.size();
+}
+
+/// <summary>
+/// Get the writer connection. Blocks until the writer is released by other lease
+/// </summary>
+/// <returns></returns>
+SQLConnectionPool::Lease SQLConnectionPool::AcquireWriter()
+{
+	std::unique_lock<std::mutex> lock(m);
+	writerReleased.wait(lock, [this] { return writerInUse == false; });
+	writerInUse = true;
+
+	return Lease(shared_from_this(), writer, true);
+}
+
+/// <summary>
+/// Get a read-only connection. Blocks until some reader is free.
+/// If no reader could be opened, empty lease is returned (the writer is not used 
+/// instead - reads would be serialized with writes and a thread already holding 
+/// the writer lease would deadlock). Use AcquireWriter explicitly in that case
+/// </summary>
+/// <returns>empty lease if the pool has no readers</returns>
+SQLConnectionPool::Lease SQLConnectionPool::AcquireReader()
+{
+	if (readers.empty())
+	{
+		return Lease();
+	}
+
+	std::unique_lock<std::mutex> lock(m);
+	readerReleased.wait(lock, [this] { return freeReaders > 0; });
+
+	std::thread::id current = std::this_thread::get_id();
+	ReaderEntry * selected = nullptr;
+	for (auto & r : readers)
+	{
+		if (r.inUse)
+		{
+			continue;
+		}
+
+		selected = &r;
+		if (r.lastThread == current)
+		{
+			break;
+		}
+	}
+
+	selected->inUse = true;
+	selected->lastThread = current;
+	freeReaders--;
+
+	return Lease(shared_from_this(), selected->connection, false);
+}
+
+void SQLConnectionPool::Release(const std::shared_ptr<SQLiteWrapper> & connection, bool writer)
+{
+	{
+		std::lock_guard<std::mutex> lock(m);
+		if (writer)
+		{
+			writerInUse = false;
+		}
+		else
+		{
+			for (auto & r : readers)
+			{
+				if (r.connection == connection)
+				{
+					r.inUse = false;
+					freeReaders++;
+					break;
+				}
+			}
+		}
+	}
+
+	if (writer)
+	{
+		writerReleased.notify_one();
+	}
+	else
+	{
+		readerReleased.notify_one();
+	}
+}
+
+//==============================================================================
+
+SQLConnectionPool::Lease::Lease() :
+	writer(false)
+{
+}
+
+SQLConnectionPool::Lease::Lease(std::shared_ptr<SQLConnectionPool> pool, 
+	std::shared_ptr<SQLiteWrapper> connection, bool writer) :
+	pool(pool),
+	connection(connection),
+	writer(writer)
+{
+}
+
+SQLConnectionPool::Lease::Lease(Lease && other) noexcept :
+	pool(std::move(other.pool)),
+	connection(std::move(other.connection)),
+	writer(other.writer)
+{
+}
+
+SQLConnectionPool::Lease & SQLConnectionPool::Lease::operator =(Lease && other) noexcept
+{
+	if (this != &other)
+	{
+		this->Release();
+		pool = std::move(other.pool);
+		connection = std::move(other.connection);
+		writer = other.writer;
+	}
+	return *this;
+}
+
+SQLConnectionPool::Lease::~Lease()
+{
+	this->Release();
+}
+
+SQLiteWrapper * SQLConnectionPool::Lease::operator ->() const
+{
+	return connection.get();
+}
+
+SQLiteWrapper & SQLConnectionPool::Lease::operator *() const
+{
+	return *connection;
+}
+
+std::shared_ptr<SQLiteWrapper> SQLConnectionPool::Lease::Get() const
+{
+	return connection;
+}
+
+SQLConnectionPool::Lease::operator bool() const
+{
+	return connection != nullptr;
+}
+
+bool SQLConnectionPool::Lease::IsWriter() const
+{
+	return writer;
+}
+
+void SQLConnectionPool::Lease::Release()
+{
+	if (pool == nullptr)
+	{
+		return;
+	}
+
+	pool->Release(connection, writer);
+	pool = nullptr;
+	connection = nullptr;
+}
@@ -0,0 +1,106 @@
+#ifndef SQLConnectionPool_hpp
+#define SQLConnectionPool_hpp
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+class SQLiteWrapper;
+
+/// <summary>
+/// Pool of connections to a single database file in WAL mode.
+/// There is one writer connection and N read-only connections, 
+/// so readers run in parallel and do not block (and are not blocked by) the writer.
+/// 
+/// Connections are opened with NoMutex - each one is used only by the thread 
+/// that holds its lease. Every connection has its own statement cache.
+/// Reader that was last used by the calling thread is preferred, 
+/// so its cached statements and pages are reused.
+/// 
+/// Pool can not be used with in-memory databases (every connection would have its own DB),
+/// Open fails if the database can not be switched to WAL mode.
+/// 
+/// Usage:
+/// auto pool = SQLConnectionPool::Open("data.db", 8);
+/// {
+///		auto r = pool->AcquireReader();
+///		auto res = r->Query("SELECT ...").Select();
+/// } //connection is returned to the pool
+/// </summary>
+class SQLConnectionPool
+	: public std::enable_shared_from_this<SQLConnectionPool>
+{
+public:
+
+	/// <summary>
+	/// RAII lease of a single connection. Connection is returned 
+	/// to the pool when lease is destroyed or Release is called.
+	/// Connection must not be used after that
+	/// </summary>
+	class Lease
+	{
+	public:
+		Lease();
+		Lease(Lease && other) noexcept;
+		Lease(const Lease &) = delete;
+		Lease & operator =(const Lease &) = delete;
+		Lease & operator =(Lease && other) noexcept;
+
+		~Lease();
+
+		SQLiteWrapper * operator ->() const;
+		SQLiteWrapper & operator *() const;
+		std::shared_ptr<SQLiteWrapper> Get() const;
+
+		explicit operator bool() const;
+
+		bool IsWriter() const;
+		void Release();
+
+		friend class SQLConnectionPool;
+
+	protected:
+		std::shared_ptr<SQLConnectionPool> pool;
+		std::shared_ptr<SQLiteWrapper> connection;
+		bool writer;
+
+		Lease(std::shared_ptr<SQLConnectionPool> pool, std::shared_ptr<SQLiteWrapper> connection, bool writer);
+	};
+
+	static std::shared_ptr<SQLConnectionPool> Open(const std::string & path, 
+		size_t readersCount = 0, int busyTimeoutMs = 5000);
+
+	~SQLConnectionPool() = default;
+
+	Lease AcquireWriter();
+	Lease AcquireReader();
+
+	size_t GetReadersCount() const;
+
+protected:
+	typedef struct ReaderEntry
+	{
+		std::shared_ptr<SQLiteWrapper> connection;
+		std::thread::id lastThread;
+		bool inUse;
+	} ReaderEntry;
+
+	std::mutex m;
+	std::condition_variable writerReleased;
+	std::condition_variable readerReleased;
+
+	std::shared_ptr<SQLiteWrapper> writer;
+	bool writerInUse;
+
+	std::vector<ReaderEntry> readers;
+	size_t freeReaders;
+
+	SQLConnectionPool();
+
+	void Release(const std::shared_ptr<SQLiteWrapper> & connection, bool writer);
+};
+
+#endif /* SQLConnectionPool_hpp */
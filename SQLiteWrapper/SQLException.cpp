@@ -0,0 +1,101 @@
+#include "SQLException.h"
+
+SQLException::SQLException(int extendedCode, const std::string & msg, const std::string & sql) :
+	std::runtime_error(msg),
+	extendedCode(extendedCode),
+	sql(sql)
+{
+}
+
+/// <summary>
+/// Primary result code (SQLITE_BUSY, SQLITE_CONSTRAINT...)
+/// </summary>
+/// <returns></returns>
+int SQLException::GetCode() const
+{
+	return extendedCode & 0xFF;
+}
+
+/// <summary>
+/// Extended result code (SQLITE_BUSY_SNAPSHOT, SQLITE_CONSTRAINT_UNIQUE...)
+/// </summary>
+/// <returns></returns>
+int SQLException::GetExtendedCode() const
+{
+	return extendedCode;
+}
+
+const std::string & SQLException::GetSql() const
+{
+	return sql;
+}
+
+/// <summary>
+/// Database is locked by other connection (SQLITE_BUSY) 
+/// or by other statement / shared cache connection (SQLITE_LOCKED).
+/// Operation may succeed, if it is retried later
+/// </summary>
+/// <returns></returns>
+bool SQLException::IsBusy() const
+{
+	int code = this->GetCode();
+	return (code == SQLITE_BUSY) || (code == SQLITE_LOCKED);
+}
+
+bool SQLException::IsConstraint() const
+{
+	return (this->GetCode() == SQLITE_CONSTRAINT);
+}
+
+/// <summary>
+/// Create exception from result code. If the connection holds error with 
+/// the same primary code, its extended code and message are used
+/// </summary>
+/// <param name="code"></param>
+/// <param name="db"></param>
+/// <param name="sql"></param>
+SQLException SQLException::Create(int code, sqlite3 * db, const char * sql)
+{
+	int extendedCode = code;
+	std::string msg = sqlite3_errstr(code);
+
+	if ((db != nullptr) && (sqlite3_errcode(db) == (code & 0xFF)))
+	{
+		extendedCode = sqlite3_extended_errcode(db);
+		msg = sqlite3_errmsg(db);
+	}
+
+	std::string s = (sql != nullptr) ? sql : "";
+	return SQLException(extendedCode, "SQLite error " + std::to_string(extendedCode) + ": " + msg + 
+		((s.empty()) ? "" : " (" + s + ")"), s);
+}
+
+SQLException SQLException::Create(int code, sqlite3_stmt * stmt)
+{
+	sqlite3 * db = (stmt != nullptr) ? sqlite3_db_handle(stmt) : nullptr;
+	const char * sql = (stmt != nullptr) ? sqlite3_sql(stmt) : nullptr;
+	return SQLException::Create(code, db, sql);
+}
+
+void SQLException::Throw(int code, sqlite3 * db, const char * sql)
+{
+	throw SQLException::Create(code, db, sql);
+}
+
+void SQLException::Throw(int code, sqlite3_stmt * stmt)
+{
+	throw SQLException::Create(code, stmt);
+}
+
+/// <summary>
+/// Throw exception for failed step. Statement is reset after the error 
+/// is read, so it can be bound and stepped again (e.g. retry after SQLITE_BUSY)
+/// </summary>
+/// <param name="code"></param>
+/// <param name="stmt"></param>
+void SQLException::ThrowStep(int code, sqlite3_stmt * stmt)
+{
+	SQLException e = SQLException::Create(code, stmt);
+	sqlite3_reset(stmt);
+	throw e;
+}
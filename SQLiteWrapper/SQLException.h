@@ -0,0 +1,54 @@
+#ifndef SQLException_hpp
+#define SQLException_hpp
+
+#include <stdexcept>
+#include <string>
+
+#include "sqlite3.h"
+
+/// <summary>
+/// Error reported by SQLite. Thrown when statement can not be prepared,
+/// a parameter can not be bound or a step fails.
+/// 
+/// Busy / locked database is reported with IsBusy, so the operation 
+/// (or the whole transaction) can be retried:
+/// 
+/// try { ... } 
+/// catch (const SQLException & e) { if (e.IsBusy()) retry(); else throw; }
+/// </summary>
+class SQLException : public std::runtime_error
+{
+public:
+	SQLException(int extendedCode, const std::string & msg, const std::string & sql);
+
+	int GetCode() const;
+	int GetExtendedCode() const;
+	const std::string & GetSql() const;
+
+	bool IsBusy() const;
+	bool IsConstraint() const;
+
+	static SQLException Create(int code, sqlite3 * db, const char * sql);
+	static SQLException Create(int code, sqlite3_stmt * stmt);
+
+	[[noreturn]] static void Throw(int code, sqlite3 * db, const char * sql);
+	[[noreturn]] static void Throw(int code, sqlite3_stmt * stmt);
+	[[noreturn]] static void ThrowStep(int code, sqlite3_stmt * stmt);
+
+protected:
+	int extendedCode;
+	std::string sql;
+};
+
+/// <summary>
+/// Throw SQLException if the call fails. Success costs a single comparison,
+/// exception is created out of line
+/// </summary>
+#define SQLITE_CHECK_THROW(stmt, sqlStmt) do { \
+	int r = stmt; \
+	if (r != SQLITE_OK && r != SQLITE_DONE && r != SQLITE_ROW){ \
+		SQLException::Throw(r, sqlStmt); \
+	} \
+	} while (0);
+
+#endif /* SQLException_hpp */
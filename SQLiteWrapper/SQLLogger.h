@@ -7,14 +7,14 @@
 #endif
 
 #ifdef __ANDROID_API__
-#define SQL_LOG(s, r, p) __android_log_print(ANDROID_LOG_ERROR, "SQLite", s, r, p);
+#define SQL_LOG(...) __android_log_print(ANDROID_LOG_ERROR, "SQLite", __VA_ARGS__);
 #else
 
 #if __has_include("../Logger.h")
 #	include "../Logger.h"
-#	define SQL_LOG(s, r, p) MY_LOG_ERROR(s, r, p);
+#	define SQL_LOG(...) MY_LOG_ERROR(__VA_ARGS__);
 #else
-#	define SQL_LOG(s, r, p) printf(s, r, p)
+#	define SQL_LOG(...) printf(__VA_ARGS__)
 #endif
 
 #endif
@@ -0,0 +1,135 @@
+#include "SQLMappedFile.h"
+
+#ifdef _WIN32
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	include <windows.h>
+#else
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+SQLMappedFile::SQLMappedFile(const std::string & path) :
+	data(nullptr),
+	size(0),
+	opened(false)
+{
+#ifdef _WIN32
+	this->fileHandle = INVALID_HANDLE_VALUE;
+	this->mappingHandle = nullptr;
+
+	HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (f == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+	this->fileHandle = f;
+
+	LARGE_INTEGER fileSize;
+	if (GetFileSizeEx(f, &fileSize) == FALSE)
+	{
+		return;
+	}
+
+	this->opened = true;
+	this->size = static_cast<size_t>(fileSize.QuadPart);
+	if (this->size == 0)
+	{
+		//empty file can not be mapped
+		return;
+	}
+
+	HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m == nullptr)
+	{
+		this->opened = false;
+		return;
+	}
+	this->mappingHandle = m;
+
+	this->data = static_cast<const char *>(MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0));
+	if (this->data == nullptr)
+	{
+		this->opened = false;
+	}
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+	{
+		close(fd);
+		return;
+	}
+
+	this->opened = true;
+	this->size = static_cast<size_t>(st.st_size);
+	if (this->size > 0)
+	{
+		void * p = mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (p == MAP_FAILED)
+		{
+			this->opened = false;
+		}
+		else
+		{
+			this->data = static_cast<const char *>(p);
+			madvise(p, this->size, MADV_SEQUENTIAL);
+		}
+	}
+
+	//mapping stays valid after the descriptor is closed
+	close(fd);
+#endif
+
+	if (this->opened == false)
+	{
+		this->size = 0;
+	}
+}
+
+SQLMappedFile::~SQLMappedFile()
+{
+#ifdef _WIN32
+	if (this->data != nullptr)
+	{
+		UnmapViewOfFile(this->data);
+	}
+	if (this->mappingHandle != nullptr)
+	{
+		CloseHandle(this->mappingHandle);
+	}
+	if (this->fileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(this->fileHandle);
+	}
+#else
+	if (this->data != nullptr)
+	{
+		munmap(const_cast<char *>(this->data), this->size);
+	}
+#endif
+}
+
+bool SQLMappedFile::IsOpen() const
+{
+	return opened;
+}
+
+const char * SQLMappedFile::GetData() const
+{
+	return data;
+}
+
+size_t SQLMappedFile::GetSize() const
+{
+	return size;
+}
@@ -0,0 +1,38 @@
+#ifndef SQLMappedFile_hpp
+#define SQLMappedFile_hpp
+
+#include <string>
+#include <cstddef>
+
+/// <summary>
+/// Read-only memory mapped file (mmap / MapViewOfFile).
+/// Used for bulk imports, so the file content can be bound to statements 
+/// directly without copying it into buffers.
+/// Mapping is released in destructor
+/// </summary>
+class SQLMappedFile
+{
+public:
+	SQLMappedFile(const std::string & path);
+	SQLMappedFile(const SQLMappedFile &) = delete;
+	SQLMappedFile & operator =(const SQLMappedFile &) = delete;
+
+	~SQLMappedFile();
+
+	bool IsOpen() const;
+
+	const char * GetData() const;
+	size_t GetSize() const;
+
+protected:
+	const char * data;
+	size_t size;
+	bool opened;
+
+#ifdef _WIN32
+	void * fileHandle;
+	void * mappingHandle;
+#endif
+};
+
+#endif /* SQLMappedFile_hpp */
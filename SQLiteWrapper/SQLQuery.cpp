@@ -10,6 +10,7 @@
 #include <string.h>
 
 #include "SQLiteWrapper.h"
+#include "SQLStatementCache.h"
 
 SQLQuery::SQLQuery()
 	: SQLQuery(nullptr)
@@ -30,18 +31,43 @@ SQLQuery::SQLQuery(sqlite3_stmt * stmt)
     this->autoBind = true;
 }
 
+/// <summary>
+/// Statement is owned by the connection statement cache.
+/// Once the last reference is gone, statement is returned to the cache
+/// instead of being finalized. If the cache (connection) no longer exist,
+/// statement is finalized.
+/// </summary>
+/// <param name="stmt"></param>
+/// <param name="cache"></param>
+SQLQuery::SQLQuery(sqlite3_stmt * stmt, std::weak_ptr<SQLStatementCache> cache)
+{
+    this->stmt = std::shared_ptr<sqlite3_stmt>(stmt, [cache](sqlite3_stmt* stmt)
+                                               {
+                                                   if (auto c = cache.lock())
+                                                   {
+                                                       c->Release(stmt);
+                                                   }
+                                                   else
+                                                   {
+                                                       sqlite3_finalize(stmt);
+                                                   }
+                                               });
+    this->autoBind = true;
+}
+
 void SQLQuery::ClearBindings()
 {
     this->autoBind = true;
     if (stmt.get() != nullptr)
     {
-        SQLITE_CHECK(sqlite3_clear_bindings( stmt.get() ));
+        SQLITE_CHECK_THROW(sqlite3_clear_bindings( stmt.get() ), stmt.get());
     }
 }
 
 void SQLQuery::Reset()
 {
-    SQLITE_CHECK(sqlite3_reset( stmt.get() ));
+    //error of the previous step is already reported by the step (and statement reset)
+    SQLITE_CHECK_THROW(sqlite3_reset( stmt.get() ), stmt.get());
 }
 
 
@@ -63,11 +89,82 @@ void SQLQuery::Execute()
         this->ClearBindings();
     }
     this->ExecuteStep();
+    //statement must be reset before parameters can be bound again
+    this->Reset();
 }
 
 void SQLQuery::ExecuteStep()
 {
-    SQLITE_CHECK(sqlite3_step( stmt.get() ));
+    //empty SQL (only whitespace or comment) has no statement
+    if (stmt.get() == nullptr)
+    {
+        return;
+    }
+    
+    int r = sqlite3_step( stmt.get() );
+    if ((r != SQLITE_DONE) && (r != SQLITE_ROW))
+    {
+        SQLException::ThrowStep(r, stmt.get());
+    }
+}
+
+int SQLQuery::GetParamsCount() const
+{
+    return sqlite3_bind_parameter_count( stmt.get() );
+}
+
+SQLParam SQLQuery::GetParam(std::string_view name) const
+{
+    return findParam( stmt.get(), paramNames, name );
+}
+
+/// <summary>
+/// Find index of named parameter. 
+/// All parameter names are read from the statement at once on the first call,
+/// later lookups do not call sqlite3 at all.
+/// Name without prefix matches any prefix (":id", "@id", "$id", "?1")
+/// </summary>
+/// <param name="stmt"></param>
+/// <param name="names">lookup table of the statement, filled on the first call</param>
+/// <param name="name"></param>
+/// <returns></returns>
+SQLParam SQLQuery::findParam(sqlite3_stmt * stmt, ParamNames & names, std::string_view name)
+{
+    SQLParam p;
+    if (stmt == nullptr)
+    {
+        return p;
+    }
+
+    if (names.empty())
+    {
+        int count = sqlite3_bind_parameter_count( stmt );
+        names.reserve(count);
+        for (int i = 1; i <= count; i++)
+        {
+            //nameless parameter "?" has no name
+            if (const char * n = sqlite3_bind_parameter_name( stmt, i ))
+            {
+                names.emplace_back(std::string_view(n), i);
+            }
+        }
+    }
+
+    bool hasPrefix = (name.empty() == false) && 
+        ((name[0] == ':') || (name[0] == '@') || (name[0] == '$') || (name[0] == '?'));
+
+    for (const auto & it : names)
+    {
+        std::string_view n = (hasPrefix) ? it.first : it.first.substr(1);
+        if (n == name)
+        {
+            p.index = it.second;
+            return p;
+        }
+    }
+
+    SQL_LOG("SQLite error: unknown parameter %.*s\n", static_cast<int>(name.length()), name.data());
+    return p;
 }
 
 std::vector<std::string> SQLQuery::GetColumnNames() const
@@ -82,34 +179,139 @@ std::vector<std::string> SQLQuery::GetColumnNames() const
 }
 
 
+void SQLQuery::set(sqlite3_stmt *stmt, int index, std::nullptr_t) 
+{
+    SQLITE_CHECK_THROW(sqlite3_bind_null( stmt, index ), stmt);
+}
+
 void SQLQuery::set(sqlite3_stmt *stmt, int index, int value) 
 {
-    SQLITE_CHECK(sqlite3_bind_int( stmt, index, value ));
+    SQLITE_CHECK_THROW(sqlite3_bind_int( stmt, index, value ), stmt);
+}
+
+void SQLQuery::set(sqlite3_stmt *stmt, int index, sqlite3_int64 value) 
+{
+    SQLITE_CHECK_THROW(sqlite3_bind_int64( stmt, index, value ), stmt);
 }
 
 void SQLQuery::set(sqlite3_stmt *stmt, int index, double value) 
 {
-    SQLITE_CHECK(sqlite3_bind_double( stmt, index, value ));
+    SQLITE_CHECK_THROW(sqlite3_bind_double( stmt, index, value ), stmt);
 }
 
-void SQLQuery::set(sqlite3_stmt *stmt, int index, float value) 
+void SQLQuery::set(sqlite3_stmt *stmt, int index, const std::string & value) 
 {
-    SQLITE_CHECK(sqlite3_bind_double( stmt, index, (double) value ));
+    SQLITE_CHECK_THROW(sqlite3_bind_text( stmt, index, value.c_str(), (int) value.length(), SQLITE_TRANSIENT ), stmt);
 }
 
-void SQLQuery::set(sqlite3_stmt *stmt, int index, std::string value) 
+void SQLQuery::set(sqlite3_stmt *stmt, int index, std::string_view value) 
 {
-    SQLITE_CHECK(sqlite3_bind_text( stmt, index, value.c_str(), (int) value.length(), SQLITE_TRANSIENT ));
+    //data() of empty view may be nullptr - that would bind NULL instead of empty string
+    const char * data = (value.data() != nullptr) ? value.data() : "";
+    SQLITE_CHECK_THROW(sqlite3_bind_text64( stmt, index, data, value.length(), SQLITE_TRANSIENT, SQLITE_UTF8 ), stmt);
 }
 
 void SQLQuery::set(sqlite3_stmt *stmt, int index, const char * value) 
 {
-    SQLITE_CHECK(sqlite3_bind_text( stmt, index, value, (int) strlen( value ), SQLITE_TRANSIENT ));
+    if (value == nullptr)
+    {
+        set(stmt, index, nullptr);
+        return;
+    }
+    SQLITE_CHECK_THROW(sqlite3_bind_text( stmt, index, value, (int) strlen( value ), SQLITE_TRANSIENT ), stmt);
+}
+
+void SQLQuery::set(sqlite3_stmt *stmt, int index, const std::vector<uint8_t> & value) 
+{
+    set(stmt, index, SQLBlob(value));
+}
+
+void SQLQuery::set(sqlite3_stmt *stmt, int index, SQLBlobView value) 
+{
+    if ((value.data == nullptr) || (value.size == 0))
+    {
+        //nullptr data would bind NULL
+        SQLITE_CHECK_THROW(sqlite3_bind_zeroblob( stmt, index, 0 ), stmt);
+        return;
+    }
+    SQLITE_CHECK_THROW(sqlite3_bind_blob64( stmt, index, value.data, value.size, SQLITE_TRANSIENT ), stmt);
+}
+
+#ifdef __cpp_lib_span
+void SQLQuery::set(sqlite3_stmt *stmt, int index, std::span<const uint8_t> value) 
+{
+    set(stmt, index, SQLBlob(value.data(), value.size()));
+}
+#endif
+
+void SQLQuery::set(sqlite3_stmt *stmt, int index, SQLZeroBlob value) 
+{
+    SQLITE_CHECK_THROW(sqlite3_bind_zeroblob64( stmt, index, value.size ), stmt);
+}
+
+/// <summary>
+/// Bind text without copy. Data must be valid until the statement is executed
+/// </summary>
+/// <param name="stmt"></param>
+/// <param name="index"></param>
+/// <param name="value"></param>
+void SQLQuery::set(sqlite3_stmt *stmt, int index, const SQLStaticText & value) 
+{
+    const char * data = (value.data != nullptr) ? value.data : "";
+    SQLITE_CHECK_THROW(sqlite3_bind_text64( stmt, index, data, value.length, SQLITE_STATIC, SQLITE_UTF8 ), stmt);
 }
 
-void SQLQuery::set(sqlite3_stmt *stmt, int index, char * value) 
+/// <summary>
+/// Bind blob without copy. Data must be valid until the statement is executed
+/// </summary>
+/// <param name="stmt"></param>
+/// <param name="index"></param>
+/// <param name="value"></param>
+void SQLQuery::set(sqlite3_stmt *stmt, int index, const SQLStaticBlob & value) 
 {
-    SQLITE_CHECK(sqlite3_bind_text( stmt, index, value, (int) strlen( value ), SQLITE_TRANSIENT ));
+    if ((value.data == nullptr) || (value.size == 0))
+    {
+        //nullptr data would bind NULL
+        SQLITE_CHECK_THROW(sqlite3_bind_zeroblob( stmt, index, 0 ), stmt);
+        return;
+    }
+    SQLITE_CHECK_THROW(sqlite3_bind_blob64( stmt, index, value.data, value.size, SQLITE_STATIC ), stmt);
+}
+
+/// <summary>
+/// Move text buffer to SQLite. Buffer is released by SQLite 
+/// (also if binding fails)
+/// </summary>
+/// <param name="stmt"></param>
+/// <param name="index"></param>
+/// <param name="value"></param>
+void SQLQuery::set(sqlite3_stmt *stmt, int index, SQLOwnedText && value) 
+{
+    if (value.data == nullptr)
+    {
+        SQLITE_CHECK_THROW(sqlite3_bind_text( stmt, index, "", 0, SQLITE_STATIC ), stmt);
+        return;
+    }
+    SQLITE_CHECK_THROW(sqlite3_bind_text64( stmt, index, value.data.release(), value.length, 
+        [](void * p) { delete[] static_cast<char *>(p); }, SQLITE_UTF8 ), stmt);
+}
+
+/// <summary>
+/// Move blob buffer to SQLite. Buffer is released by SQLite 
+/// (also if binding fails)
+/// </summary>
+/// <param name="stmt"></param>
+/// <param name="index"></param>
+/// <param name="value"></param>
+void SQLQuery::set(sqlite3_stmt *stmt, int index, SQLOwnedBlob && value) 
+{
+    if (value.data == nullptr)
+    {
+        SQLITE_CHECK_THROW(sqlite3_bind_zeroblob( stmt, index, 0 ), stmt);
+        return;
+    }
+    SQLITE_CHECK_THROW(sqlite3_bind_blob64( stmt, index, value.data.release(), value.size, 
+        [](void * p) { delete[] static_cast<uint8_t *>(p); } ), stmt);
 }
 
 
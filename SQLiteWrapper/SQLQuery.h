@@ -12,11 +12,34 @@
 #include <memory>
 #include <vector>
 #include <string>
-#include <sstream>
+#include <string_view>
+#include <utility>
+#include <optional>
+#include <cstddef>
+#include <type_traits>
 
 #include "sqlite3.h"
 
 #include "SQLResult.h"
+#include "SQLBindValues.h"
+
+class SQLStatementCache;
+
+/// <summary>
+/// Resolved index of a named parameter.
+/// Obtained once with SQLQuery::GetParam and reused in loops,
+/// binding via handle costs the same as positional binding
+/// </summary>
+typedef struct SQLParam
+{
+	int index = 0;	//0 - parameter not found
+
+	bool IsValid() const { return index > 0; }
+} SQLParam;
+
+//defined in SQLBindTraits.h
+template <typename T, typename Enable = void>
+struct SQLBindTraits;
 
 class SQLQuery
 {
@@ -27,74 +50,127 @@ public:
     SQLResult Select();
     
     template <typename T, typename... Args>
-    SQLResult Select( T t, Args... args )
+    SQLResult Select( T && t, Args &&... args )
     {
         this->Reset();
         this->ClearBindings();
-        set( stmt.get(), 1, t, args... );
+        setAll( stmt.get(), 1, std::forward<T>(t), std::forward<Args>(args)... );
         return SQLResult( stmt );
     }
     
     void Execute();
     
     template <typename T, typename... Args>
-    void Execute( T t, Args... args )
+    void Execute( T && t, Args &&... args )
     {
         this->Reset();
         this->ClearBindings();
-        set( stmt.get(), 1, t, args... );
+        setAll( stmt.get(), 1, std::forward<T>(t), std::forward<Args>(args)... );
         this->ExecuteStep();
     }
     
     void ClearBindings();
     
     template <typename T>
-    void Bind(T t, int index)
+    void Bind(T && t, int index)
+    {
+        this->autoBind = false;
+        setValue(stmt.get(), index, std::forward<T>(t));
+    }
+    
+    /// <summary>
+    /// Bind value to named parameter (":name", "@name", "$name").
+    /// Name can be passed with or without the prefix.
+    /// Do not mix with Select / Execute with arguments - they clear bindings
+    /// </summary>
+    template <typename T>
+    void BindNamed(std::string_view name, T && t)
+    {
+        this->BindNamed(this->GetParam(name), std::forward<T>(t));
+    }
+    
+    template <typename T>
+    void BindNamed(const SQLParam & param, T && t)
     {
         this->autoBind = false;
-        set(stmt.get(), index, t);
+        setValue(stmt.get(), param.index, std::forward<T>(t));
     }
     
+    SQLParam GetParam(std::string_view name) const;
+    int GetParamsCount() const;
+    
     std::vector<std::string> GetColumnNames() const;
     
     friend class SQLiteWrapper;
 	friend class SQLKeyValueTable;
+	friend class SQLBulkInserter;
+	friend class SQLTable;
+	friend class SQLStatement;
+	template <typename T, typename Enable> friend struct SQLBindTraits;
+	friend struct SQLBindBuiltin;
     
 protected:
     std::shared_ptr<sqlite3_stmt> stmt;
     bool autoBind;
     
+    //names of parameters and their indices, filled on first named lookup
+    //names point to the statement memory (valid for the lifetime of stmt)
+    typedef std::vector<std::pair<std::string_view, int>> ParamNames;
+    mutable ParamNames paramNames;
+    
 	SQLQuery();
     SQLQuery(sqlite3_stmt * stmt);
+    SQLQuery(sqlite3_stmt * stmt, std::weak_ptr<SQLStatementCache> cache);
     
     
     void Reset();
     void ExecuteStep();
     
-	void set(sqlite3_stmt *stmt, int index, int value);
-	void set(sqlite3_stmt *stmt, int index, double value);
-	void set(sqlite3_stmt *stmt, int index, float value);
-	void set(sqlite3_stmt *stmt, int index, std::string value);
-	void set(sqlite3_stmt *stmt, int index, const char * value);
-	void set(sqlite3_stmt *stmt, int index, char * value);
+    static SQLParam findParam(sqlite3_stmt * stmt, ParamNames & names, std::string_view name);
+    
+	//built-in binders, used by SQLBindTraits specializations
+	static void set(sqlite3_stmt *stmt, int index, std::nullptr_t);
+	static void set(sqlite3_stmt *stmt, int index, int value);
+	static void set(sqlite3_stmt *stmt, int index, sqlite3_int64 value);
+	static void set(sqlite3_stmt *stmt, int index, double value);
+	static void set(sqlite3_stmt *stmt, int index, const std::string & value);
+	static void set(sqlite3_stmt *stmt, int index, std::string_view value);
+	static void set(sqlite3_stmt *stmt, int index, const char * value);
+	static void set(sqlite3_stmt *stmt, int index, const std::vector<uint8_t> & value);
+	static void set(sqlite3_stmt *stmt, int index, SQLBlobView value);
+#ifdef __cpp_lib_span
+	static void set(sqlite3_stmt *stmt, int index, std::span<const uint8_t> value);
+#endif
+	static void set(sqlite3_stmt *stmt, int index, SQLZeroBlob value);
+	static void set(sqlite3_stmt *stmt, int index, const SQLStaticText & value);
+	static void set(sqlite3_stmt *stmt, int index, const SQLStaticBlob & value);
+	static void set(sqlite3_stmt *stmt, int index, SQLOwnedText && value);
+	static void set(sqlite3_stmt *stmt, int index, SQLOwnedBlob && value);
 
+    /// <summary>
+    /// Bind value via SQLBindTraits selected at compile time. 
+    /// Value is forwarded, there is no copy
+    /// </summary>
     template <typename T>
-    void set( sqlite3_stmt *stmt, int index, T value)
+    static void setValue( sqlite3_stmt *stmt, int index, T && value)
     {
-        std::ostringstream stream;
-        stream << value;
-        std::string text( stream.str() );
-        set(stmt, index, text); //will call set with std::string       
+        SQLBindTraits<typename std::decay<T>::type>::Bind( stmt, index, std::forward<T>(value) );
     }
     
+    static void setAll( sqlite3_stmt *, int )
+    {
+    }
+
     template<typename T, typename... Args>
-    void set( sqlite3_stmt *stmt, int index, T value, Args... args)
+    static void setAll( sqlite3_stmt *stmt, int index, T && value, Args &&... args)
     {
-        set( stmt, index, value );
-        set( stmt, index + 1, args...);
+        setValue( stmt, index, std::forward<T>(value) );
+        setAll( stmt, index + 1, std::forward<Args>(args)...);
     }
     
     
 };
 
+#include "SQLBindTraits.h"
+
 #endif /* SQLQuery_hpp */
@@ -8,25 +8,67 @@
 
 #include "SQLResult.h"
 
-SQLResult::SQLResult(std::shared_ptr<sqlite3_stmt> stmt) : stmt(stmt), isValid(true), row(this, stmt)
+#include <stdexcept>
+#include <string>
+
+#include "SQLException.h"
+
+SQLResult::SQLResult(std::shared_ptr<sqlite3_stmt> stmt) : 
+    stmt(stmt), isValid(true), started(false), row(this, stmt.get())
+{
+}
+
+/// <summary>
+/// Move result, the source is left without statement (no rows).
+/// Row always points to its own result, so it is not moved
+/// </summary>
+/// <param name="other"></param>
+SQLResult::SQLResult(SQLResult && other) noexcept :
+    stmt(std::move(other.stmt)), 
+    isValid(other.isValid), 
+    started(other.started), 
+    row(this, stmt.get()),
+    assocKeyMapping(std::move(other.assocKeyMapping)),
+    batchTypes(std::move(other.batchTypes))
 {
+    other.isValid = false;
+    other.row = SQLRow(&other, nullptr);
 }
 
-SQLResult::SQLResult( const SQLResult & res) :
-    stmt(res.stmt), isValid(res.isValid), row(this, res.stmt)
+SQLResult & SQLResult::operator =(SQLResult && other) noexcept
 {
+    if (this != &other)
+    {
+        stmt = std::move(other.stmt);
+        isValid = other.isValid;
+        started = other.started;
+        row = SQLRow(this, stmt.get());
+        assocKeyMapping = std::move(other.assocKeyMapping);
+        batchTypes = std::move(other.batchTypes);
+
+        other.isValid = false;
+        other.row = SQLRow(&other, nullptr);
+    }
+    return *this;
 }
 
-const SQLResult::const_iterator SQLResult::begin()
+/// <summary>
+/// Fetch the first row. Repeated calls do not move to the next row
+/// </summary>
+/// <returns></returns>
+SQLResult::iterator SQLResult::begin()
 {
-    this->isValid = true;
-    this->GetNextRow();
-    return SQLResult::const_iterator( this );
+    if (this->started == false)
+    {
+        this->started = true;
+        this->GetNextRow();
+    }
+    return SQLResult::iterator( this );
 }
 
-const SQLResult::const_iterator SQLResult::end()
+SQLResult::sentinel SQLResult::end()
 {
-    return SQLResult::const_iterator( this );
+    return SQLResult::sentinel();
 }
 
 const SQLRow * SQLResult::GetNextRow()
@@ -38,9 +80,14 @@ const SQLRow * SQLResult::GetNextRow()
     }
     
     
-    if ( sqlite3_step( stmt.get() ) != SQLITE_ROW )
+    int r = sqlite3_step( stmt.get() );
+    if ( r != SQLITE_ROW )
     {
         isValid = false;
+        if ( r != SQLITE_DONE )
+        {
+            SQLException::ThrowStep( r, stmt.get() );
+        }
         return nullptr;
     }
     return &row;
@@ -51,6 +98,7 @@ void SQLResult::Reset()
 {
     sqlite3_reset(stmt.get());
     isValid = true;
+    started = false;
 }
 
 int SQLResult::ColumnCount() const
@@ -60,6 +108,88 @@ int SQLResult::ColumnCount() const
 
 
 
+/// <summary>
+/// Fetch up to batchSize rows into columnar batch.
+/// Column types are inferred from the first fetched row and 
+/// kept for all following batches of this result.
+/// </summary>
+/// <param name="batchSize"></param>
+/// <returns>batch with 0 rows, if there are no more rows or batchSize is 0</returns>
+SQLColumnBatch SQLResult::FetchColumns(size_t batchSize)
+{
+    if ((batchSize == 0) || (this->GetNextRow() == nullptr))
+    {
+        return SQLColumnBatch();
+    }
+
+    if (batchTypes.size() == 0)
+    {
+        batchTypes = SQLColumnBatch::InferTypes(stmt.get());
+    }
+
+    SQLColumnBatch batch;
+    batch.Init(stmt.get(), batchTypes, batchSize);
+    batch.AppendRow(stmt.get());
+
+    while ((batch.GetRowsCount() < batchSize) && (this->GetNextRow() != nullptr))
+    {
+        batch.AppendRow(stmt.get());
+    }
+
+    return batch;
+}
+
+/// <summary>
+/// Fetch up to batchSize rows into columnar batch with given column types.
+/// Values are converted by SQLite to the required type.
+/// Throws std::invalid_argument if there are more types than result columns
+/// </summary>
+/// <param name="batchSize"></param>
+/// <param name="types"></param>
+/// <returns>batch with 0 rows, if there are no more rows or batchSize is 0</returns>
+SQLColumnBatch SQLResult::FetchColumns(size_t batchSize, const std::vector<SQLEnums::ValueDataType> & types)
+{
+    if (types.size() > static_cast<size_t>(this->ColumnCount()))
+    {
+        throw std::invalid_argument("FetchColumns: " + std::to_string(types.size()) + 
+            " types for " + std::to_string(this->ColumnCount()) + " columns");
+    }
+    batchTypes = types;
+    return this->FetchColumns(batchSize);
+}
+
+/// <summary>
+/// Get index of column with given name. 
+/// Throws std::out_of_range for unknown name
+/// </summary>
+/// <param name="name"></param>
+/// <returns></returns>
+int SQLResult::GetColumnIndex(const std::string & name)
+{
+    if (assocKeyMapping.size() == 0)
+    {
+        this->CreateNameIndexMapping();
+    }
+
+    auto it = assocKeyMapping.find(name);
+    if (it == assocKeyMapping.end())
+    {
+        throw std::out_of_range("Unknown column: " + name);
+    }
+    return it->second;
+}
+
+/// <summary>
+/// Resolve column name to index once. 
+/// Returned reference can be used for all rows of this result
+/// </summary>
+/// <param name="name"></param>
+/// <returns></returns>
+SQLColumnRef SQLResult::GetColumn(const std::string & name)
+{
+    return SQLColumnRef(this->GetColumnIndex(name));
+}
+
 void SQLResult::CreateNameIndexMapping()
 {
     int count = this->ColumnCount();
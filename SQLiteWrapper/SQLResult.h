@@ -12,58 +12,244 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <stdexcept>
+#include <iterator>
+#include <cstddef>
 
 #include "SQLRow.h"
+#include "SQLColumnTraits.h"
+#include "SQLColumnBatch.h"
 
+template <typename T>
+class SQLTypedResult;
 
+
+/// <summary>
+/// Result of SELECT. It is a single-pass input range over rows - 
+/// rows are stepped directly from the statement, begin() fetches the first row.
+/// To iterate again, Reset must be called.
+/// 
+/// Result owns the statement and can only be moved.
+/// </summary>
 class SQLResult
 {
 public:
 
-    class const_iterator
+    /// <summary>
+    /// End of rows, iterator is equal to it once there are no more rows
+    /// </summary>
+    struct sentinel { };
+
+    class iterator
     {
     public:
-        typedef std::forward_iterator_tag iterator_category;
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::input_iterator_tag iterator_concept;
+        typedef SQLRow value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const SQLRow * pointer;
+        typedef const SQLRow & reference;
+
+        iterator() : res(nullptr) { }
+        iterator(SQLResult * res) : res(res) { }
+        iterator & operator++() { res->GetNextRow(); return *this; }
+        void operator++(int) { res->GetNextRow(); }
+        const SQLRow & operator*() const { return res->row; }
+        const SQLRow * operator->() const { return &(res->row); }
         
-        const_iterator(SQLResult * res) : res(res) { }
-        const_iterator operator++() { res->GetNextRow(); return *this; }
-        //self_type operator++(int junk) { ptr_++; return *this; }
-        const SQLRow& operator*() { return res->row; }
-        const SQLRow* operator->() { return &(res->row); }
-        //bool operator==(const const_iterator& rhs){ return !this->res->isValid; }
-        bool operator!=(const const_iterator& rhs) { return (this->res->isValid); }
+        bool IsEnd() const { return (res == nullptr) || (res->isValid == false); }
+
+        friend bool operator==(const iterator & it, sentinel) { return it.IsEnd(); }
+        friend bool operator!=(const iterator & it, sentinel s) { return !(it == s); }
+        friend bool operator==(sentinel s, const iterator & it) { return (it == s); }
+        friend bool operator!=(sentinel s, const iterator & it) { return !(it == s); }
         
-        friend class SQLResult;
     private:
         SQLResult * res;
     };
+
+    typedef iterator const_iterator;
     
-    SQLResult( const SQLResult & res);
-    
+    SQLResult(SQLResult && other) noexcept;
+    SQLResult(const SQLResult &) = delete;
+    SQLResult & operator =(SQLResult && other) noexcept;
+    SQLResult & operator =(const SQLResult &) = delete;
     
-    const const_iterator begin();
-    const const_iterator end();
+    iterator begin();
+    sentinel end();
     
     const SQLRow * GetNextRow();
     
     void Reset();
     int ColumnCount() const;
+
+    int GetColumnIndex(const std::string & name);
+    SQLColumnRef GetColumn(const std::string & name);
+
+    template <typename T>
+    SQLTypedColumnRef<T> GetColumn(const std::string & name)
+    {
+        return SQLTypedColumnRef<T>(this->GetColumnIndex(name));
+    }
+
+    template <typename T>
+    SQLTypedResult<T> As();
+
+    SQLColumnBatch FetchColumns(size_t batchSize);
+    SQLColumnBatch FetchColumns(size_t batchSize, const std::vector<SQLEnums::ValueDataType> & types);
     
     
     friend class SQLRow;
     friend class SQLRow::RowValue;
     friend class SQLQuery;
-    friend class const_iterator;
+    template <typename T> friend class SQLTypedResult;
     
 private:
     std::shared_ptr<sqlite3_stmt> stmt;
     bool isValid;
+    bool started;
     SQLRow row;
     std::unordered_map<std::string, int> assocKeyMapping;
+    std::vector<SQLEnums::ValueDataType> batchTypes;
     
     
     SQLResult(std::shared_ptr<sqlite3_stmt> stmt);
     void CreateNameIndexMapping();
 };
 
+//===============================================================================
+
+/// <summary>
+/// Typed view of SQLResult created by SQLResult::As<T>.
+/// T is std::tuple<...> or struct mapped with SQL_ROW_MAPPING.
+/// Whole row is decoded in one pass with compile-time selected column readers.
+/// Number of columns is checked once, when the view is created.
+/// 
+/// View must not outlive the result and the result must not be moved while 
+/// the view is used. Values with views (std::string_view, SQLBlobView) 
+/// are valid until the next row is fetched.
+/// 
+/// Usage:
+/// for (auto & [id, score, name] : res.As<std::tuple<int64_t, double, std::string_view>>()) 
+/// </summary>
+template <typename T>
+class SQLTypedResult
+{
+public:
+    typedef SQLResult::sentinel sentinel;
+
+    class iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::input_iterator_tag iterator_concept;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const T * pointer;
+        typedef const T & reference;
+
+        iterator() : res(nullptr) { }
+        iterator(SQLTypedResult * res) : res(res) { }
+        iterator & operator++() { res->Next(); return *this; }
+        void operator++(int) { res->Next(); }
+        const T & operator*() const { return res->value; }
+        const T * operator->() const { return &(res->value); }
+
+        bool IsEnd() const { return (res == nullptr) || (res->res->isValid == false); }
+
+        friend bool operator==(const iterator & it, sentinel) { return it.IsEnd(); }
+        friend bool operator!=(const iterator & it, sentinel s) { return !(it == s); }
+        friend bool operator==(sentinel s, const iterator & it) { return (it == s); }
+        friend bool operator!=(sentinel s, const iterator & it) { return !(it == s); }
+
+    private:
+        SQLTypedResult * res;
+    };
+
+    typedef iterator const_iterator;
+
+    /// <summary>
+    /// Fetch the first row. Repeated calls do not move to the next row
+    /// </summary>
+    iterator begin()
+    {
+        if (started == false)
+        {
+            started = true;
+            this->Next();
+        }
+        return iterator(this);
+    }
+
+    sentinel end()
+    {
+        return sentinel();
+    }
+
+    /// <summary>
+    /// Fetch next row. Value can be moved out, it is overwritten by the next row
+    /// </summary>
+    /// <returns>nullptr if there are no more rows</returns>
+    T * Next()
+    {
+        if (res->GetNextRow() == nullptr)
+        {
+            return nullptr;
+        }
+        value = SQLRowDecoder<T>::Decode(res->stmt.get());
+        return &value;
+    }
+
+    /// <summary>
+    /// Decode all remaining rows. 
+    /// T must not contain views (std::string_view, SQLBlobView)
+    /// </summary>
+    /// <returns></returns>
+    std::vector<T> ToVector()
+    {
+        std::vector<T> v;
+        while (this->Next() != nullptr)
+        {
+            v.push_back(std::move(value));
+        }
+        return v;
+    }
+
+    friend class SQLResult;
+
+private:
+    SQLResult * res;
+    T value;
+    bool started;
+
+    SQLTypedResult(SQLResult * res) : res(res), value(), started(false)
+    {
+    }
+};
+
+template <typename T>
+SQLTypedResult<T> SQLResult::As()
+{
+    //columns are checked only once for the whole result
+    if (this->ColumnCount() < SQLRowDecoder<T>::ColumnsCount())
+    {
+        throw std::out_of_range("Result has " + std::to_string(this->ColumnCount()) + 
+            " columns, " + std::to_string(SQLRowDecoder<T>::ColumnsCount()) + " required");
+    }
+    return SQLTypedResult<T>(this);
+}
+
+#if defined(__has_include)
+#   if __has_include(<version>)
+#       include <version>
+#   endif
+#endif
+
+#ifdef __cpp_lib_ranges
+#   include <ranges>
+static_assert(std::ranges::input_range<SQLResult>, "SQLResult must be an input range");
+static_assert(std::ranges::input_range<SQLTypedResult<std::tuple<int>>>, "SQLTypedResult must be an input range");
+#endif
+
 #endif /* SQLResult_hpp */
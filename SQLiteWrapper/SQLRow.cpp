@@ -10,7 +10,7 @@
 
 #include "SQLResult.h"
 
-SQLRow::SQLRow( SQLResult * res, std::shared_ptr<sqlite3_stmt> stmt) : res(res), stmt(stmt)
+SQLRow::SQLRow( SQLResult * res, sqlite3_stmt * stmt) : res(res), stmt(stmt)
 {
 }
 
@@ -19,13 +19,21 @@ SQLRow::RowValue SQLRow::operator []( const int index ) const
     return SQLRow::RowValue( stmt, index );
 }
 
+/// <summary>
+/// Get value by column name. Name is looked up for every call, 
+/// use SQLResult::GetColumn for repeated access.
+/// Throws std::out_of_range for unknown name
+/// </summary>
+/// <param name="key"></param>
+/// <returns></returns>
 SQLRow::RowValue SQLRow::operator []( const std::string & key ) const
 {
-    if (res->assocKeyMapping.size() == 0)
-    {
-        res->CreateNameIndexMapping();
-    }
-    return this->operator[](res->assocKeyMapping[key]);
+    return this->operator[](res->GetColumnIndex(key));
+}
+
+SQLRow::RowValue SQLRow::operator []( const SQLColumnRef & col ) const
+{
+    return SQLRow::RowValue( stmt, col.GetIndex() );
 }
 
 SQLRow::RowValue SQLRow::at( const int index ) const
@@ -38,6 +46,11 @@ SQLRow::RowValue SQLRow::at( const std::string & key ) const
     return this->operator[](key);
 }
 
+SQLRow::RowValue SQLRow::at( const SQLColumnRef & col ) const
+{
+    return this->operator[](col);
+}
+
 int SQLRow::ColumnCount() const
 {
     return res->ColumnCount();
@@ -47,8 +60,8 @@ int SQLRow::ColumnCount() const
 
 std::string SQLRow::RowValue::as_string() const
 {
-    return std::string( (char*)sqlite3_column_text(stmt.get(), column),
-                       sqlite3_column_bytes(stmt.get(), column) );
+    return std::string( (char*)sqlite3_column_text(stmt, column),
+                       sqlite3_column_bytes(stmt, column) );
 }
 
 /// <summary>
@@ -62,34 +75,62 @@ std::string SQLRow::RowValue::as_string() const
 /// <returns></returns>
 const char* SQLRow::RowValue::as_cstr(int& strLen) const
 {
-    strLen = sqlite3_column_bytes(stmt.get(), column);
-    return (char*)sqlite3_column_text(stmt.get(), column);
+    strLen = sqlite3_column_bytes(stmt, column);
+    return (char*)sqlite3_column_text(stmt, column);
 }
 
 int SQLRow::RowValue::as_int() const
 {
-    return sqlite3_column_int( stmt.get(), column );
+    return sqlite3_column_int( stmt, column );
 }
 
+/// <summary>
+/// long is only 32-bit on Windows, use as_int64 for 64-bit values
+/// </summary>
+/// <returns></returns>
 long SQLRow::RowValue::as_long() const
 {
-    return static_cast<long>(sqlite3_column_int64( stmt.get(), column ));
+    return static_cast<long>(sqlite3_column_int64( stmt, column ));
+}
+
+sqlite3_int64 SQLRow::RowValue::as_int64() const
+{
+    return sqlite3_column_int64( stmt, column );
 }
 
 double SQLRow::RowValue::as_double() const
 {
-    return sqlite3_column_double( stmt.get(), column );
+    return sqlite3_column_double( stmt, column );
+}
+
+
+std::vector<uint8_t> SQLRow::RowValue::as_blob() const
+{
+    return this->as_blob_view().to_vector();
 }
 
+/// <summary>
+/// Get blob data without copy. 
+/// View is valid until sqlite3_step() or sqlite3_reset() or sqlite3_finalize() is called
+/// (same as for as_cstr)
+/// </summary>
+/// <returns></returns>
+SQLBlobView SQLRow::RowValue::as_blob_view() const
+{
+    //sqlite3_column_blob must be called before sqlite3_column_bytes
+    const uint8_t * data = static_cast<const uint8_t *>(sqlite3_column_blob(stmt, column));
+    int size = sqlite3_column_bytes(stmt, column);
+    return { data, static_cast<size_t>(size) };
+}
 
 std::string SQLRow::RowValue::GetColumnName() const
 {
-    return std::string(sqlite3_column_name(stmt.get(), column));
+    return std::string(sqlite3_column_name(stmt, column));
 }
 
 SQLEnums::ValueDataType SQLRow::RowValue::GetColumnType()
 {
-    int typeId = sqlite3_column_type(stmt.get(), column);
+    int typeId = sqlite3_column_type(stmt, column);
     
     switch (typeId) {
         case 1: return SQLEnums::ValueDataType::Integer;
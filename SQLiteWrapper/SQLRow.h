@@ -15,10 +15,30 @@
 
 #include "sqlite3.h"
 #include "SQLEnums.h"
+#include "SQLBindValues.h"
 
 class SQLResult;
 
+/// <summary>
+/// Column index resolved once by SQLResult::GetColumn.
+/// Can be reused for all rows of the result without name lookup
+/// </summary>
+class SQLColumnRef
+{
+public:
+    explicit SQLColumnRef(int index) : index(index) {}
+    int GetIndex() const { return index; }
+
+protected:
+    int index;
+};
+
 
+/// <summary>
+/// Row of SQLResult. Row and its values only hold non-owning pointer 
+/// to the statement - statement is owned by SQLResult.
+/// They are cheap to copy, but must not outlive the result.
+/// </summary>
 class SQLRow
 {
 public:
@@ -31,7 +51,10 @@ public:
         const char* as_cstr(int& strLen) const;
         int as_int() const;
         long as_long() const;
+        sqlite3_int64 as_int64() const;
         double as_double() const;
+        std::vector<uint8_t> as_blob() const;
+        SQLBlobView as_blob_view() const;
         
 		template <typename T>
 		RET_VAL_SAME(std::string) as() const
@@ -42,7 +65,7 @@ public:
 		template <typename T>
 		RET_VAL_GROUP(is_integral) as() const
 		{
-			return static_cast<T>(as_long());
+			return static_cast<T>(as_int64());
 		};
 
 		template <typename T>
@@ -51,36 +74,65 @@ public:
 			return static_cast<T>(as_double());
 		};
 
+		template <typename T>
+		RET_VAL_SAME(std::vector<uint8_t>) as() const
+		{
+			return as_blob();
+		};
+
+		template <typename T>
+		RET_VAL_SAME(SQLBlobView) as() const
+		{
+			return as_blob_view();
+		};
+
         std::string GetColumnName() const;
 		SQLEnums::ValueDataType GetColumnType();
         friend class SQLRow;
         
     private:
         
-        std::shared_ptr<sqlite3_stmt> stmt;
-        const int column;
+        sqlite3_stmt * stmt;
+        int column;
         
-        RowValue(std::shared_ptr<sqlite3_stmt> stmt, const int column ) : stmt(stmt), column( column )
+        RowValue(sqlite3_stmt * stmt, const int column ) : stmt(stmt), column( column )
         {
         }
     };
     
     RowValue operator []( const int index ) const;
     RowValue operator []( const std::string & key ) const;
+    RowValue operator []( const SQLColumnRef & col ) const;
     RowValue at( const int index ) const;
     RowValue at( const std::string & key ) const;
+    RowValue at( const SQLColumnRef & col ) const;
     int ColumnCount() const;
     
     friend class SQLResult;
     
 private:
     SQLResult * res;
-    std::shared_ptr<sqlite3_stmt> stmt;
+    sqlite3_stmt * stmt;
     
-    SQLRow( SQLResult * res, std::shared_ptr<sqlite3_stmt> stmt);
+    SQLRow( SQLResult * res, sqlite3_stmt * stmt);
     SQLRow() = default;
 };
 
+/// <summary>
+/// Column reference with value type
+/// </summary>
+template <typename T>
+class SQLTypedColumnRef : public SQLColumnRef
+{
+public:
+    explicit SQLTypedColumnRef(int index) : SQLColumnRef(index) {}
+
+    T Get(const SQLRow & row) const
+    {
+        return row[*this].template as<T>();
+    }
+};
+
 
 
 #endif /* SQLRow_hpp */
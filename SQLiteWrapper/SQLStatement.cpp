@@ -0,0 +1,126 @@
+#include "SQLStatement.h"
+
+#include "SQLiteWrapper.h"
+#include "SQLStatementCache.h"
+
+SQLStatement::SQLStatement(sqlite3_stmt * stmt, std::weak_ptr<SQLStatementCache> cache) :
+	stmt(stmt),
+	cache(cache),
+	paramsCount(sqlite3_bind_parameter_count(stmt))
+{
+}
+
+SQLStatement::SQLStatement(SQLStatement && other) noexcept :
+	stmt(other.stmt),
+	cache(std::move(other.cache)),
+	paramsCount(other.paramsCount),
+	paramNames(std::move(other.paramNames))
+{
+	other.stmt = nullptr;
+	other.paramsCount = 0;
+	other.paramNames.clear();
+}
+
+SQLStatement & SQLStatement::operator =(SQLStatement && other) noexcept
+{
+	if (this != &other)
+	{
+		this->Release();
+
+		stmt = other.stmt;
+		cache = std::move(other.cache);
+		paramsCount = other.paramsCount;
+		paramNames = std::move(other.paramNames);
+
+		other.stmt = nullptr;
+		other.paramsCount = 0;
+		other.paramNames.clear();
+	}
+	return *this;
+}
+
+SQLStatement::~SQLStatement()
+{
+	this->Release();
+}
+
+/// <summary>
+/// Return statement to the cache. If the cache (connection) no longer exist,
+/// statement is finalized
+/// </summary>
+void SQLStatement::Release()
+{
+	if (stmt == nullptr)
+	{
+		return;
+	}
+
+	if (auto c = cache.lock())
+	{
+		c->Release(stmt);
+	}
+	else
+	{
+		sqlite3_finalize(stmt);
+	}
+	stmt = nullptr;
+}
+
+bool SQLStatement::IsValid() const
+{
+	return (stmt != nullptr);
+}
+
+SQLStatement::operator bool() const
+{
+	return (stmt != nullptr);
+}
+
+sqlite3_stmt * SQLStatement::Get() const
+{
+	return stmt;
+}
+
+int SQLStatement::GetParamsCount() const
+{
+	return paramsCount;
+}
+
+/// <summary>
+/// Find index of named parameter (see SQLQuery::GetParam).
+/// Resolve names once before the loop and bind via SQLParam
+/// </summary>
+/// <param name="name"></param>
+/// <returns></returns>
+SQLParam SQLStatement::GetParam(std::string_view name) const
+{
+	return SQLQuery::findParam(stmt, paramNames, name);
+}
+
+/// <summary>
+/// Execute one step of the statement
+/// </summary>
+/// <returns>SQLITE_ROW or SQLITE_DONE, SQLException is thrown on error</returns>
+int SQLStatement::Step()
+{
+	int r = sqlite3_step(stmt);
+	if ((r != SQLITE_ROW) && (r != SQLITE_DONE))
+	{
+		SQLException::ThrowStep(r, stmt);
+	}
+	return r;
+}
+
+/// <summary>
+/// Reset statement so it can be bound and stepped again. 
+/// Bindings are kept
+/// </summary>
+void SQLStatement::Reset()
+{
+	SQLITE_CHECK_THROW(sqlite3_reset(stmt), stmt);
+}
+
+void SQLStatement::ClearBindings()
+{
+	SQLITE_CHECK_THROW(sqlite3_clear_bindings(stmt), stmt);
+}
@@ -0,0 +1,121 @@
+#ifndef SQLStatement_hpp
+#define SQLStatement_hpp
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "sqlite3.h"
+
+#include "SQLQuery.h"
+#include "SQLColumnTraits.h"
+
+class SQLStatementCache;
+
+/// <summary>
+/// Lightweight handle of prepared statement for tight insert / update loops.
+/// Created by SQLiteWrapper::Prepare.
+/// 
+/// Unlike SQLQuery, nothing is done implicitly: there is no shared_ptr,
+/// no automatic reset and no sqlite3_clear_bindings. 
+/// BindAll rebinds all parameters, so old bindings do not have to be cleared.
+/// Typical loop:
+/// 
+/// auto st = db->Prepare("INSERT INTO t VALUES(?, ?)");
+/// for (auto & i : items) 
+/// { 
+///		st.BindAll(i.id, i.name); 
+///		st.Step(); 
+///		st.Reset(); 
+/// }
+/// 
+/// Handle is move-only. Once destroyed, statement is returned to the statement cache
+/// of its connection (or finalized if the connection no longer exist).
+/// Handle must not be used from multiple threads at the same time
+/// </summary>
+class SQLStatement
+{
+public:
+	SQLStatement(SQLStatement && other) noexcept;
+	SQLStatement(const SQLStatement &) = delete;
+	SQLStatement & operator =(const SQLStatement &) = delete;
+	SQLStatement & operator =(SQLStatement && other) noexcept;
+
+	~SQLStatement();
+
+	bool IsValid() const;
+	explicit operator bool() const;
+
+	sqlite3_stmt * Get() const;
+
+	int GetParamsCount() const;
+	SQLParam GetParam(std::string_view name) const;
+
+	/// <summary>
+	/// Bind all parameters in order starting from index 1.
+	/// If the number of values is lower than number of parameters,
+	/// old bindings are cleared first (the remaining parameters are NULL)
+	/// </summary>
+	template <typename... Args>
+	void BindAll(Args &&... args)
+	{
+		if (static_cast<int>(sizeof...(Args)) < paramsCount)
+		{
+			this->ClearBindings();
+		}
+		SQLQuery::setAll(stmt, 1, std::forward<Args>(args)...);
+	}
+
+	template <typename T>
+	void Bind(int index, T && value)
+	{
+		SQLQuery::setValue(stmt, index, std::forward<T>(value));
+	}
+
+	template <typename T>
+	void Bind(const SQLParam & param, T && value)
+	{
+		SQLQuery::setValue(stmt, param.index, std::forward<T>(value));
+	}
+
+	int Step();
+	void Reset();
+	void ClearBindings();
+
+	/// <summary>
+	/// BindAll + Step + Reset
+	/// </summary>
+	/// <returns>result of the step (SQLITE_DONE / SQLITE_ROW), SQLException is thrown on error</returns>
+	template <typename... Args>
+	int Execute(Args &&... args)
+	{
+		this->BindAll(std::forward<Args>(args)...);
+		int r = this->Step();
+		this->Reset();
+		return r;
+	}
+
+	/// <summary>
+	/// Read column of the current row (after Step returned SQLITE_ROW)
+	/// </summary>
+	template <typename T>
+	T GetColumn(int column) const
+	{
+		return SQLColumnTraits<T>::Read(stmt, column);
+	}
+
+	friend class SQLiteWrapper;
+
+protected:
+	sqlite3_stmt * stmt;
+	std::weak_ptr<SQLStatementCache> cache;
+	int paramsCount;
+	mutable SQLQuery::ParamNames paramNames;
+
+	SQLStatement(sqlite3_stmt * stmt, std::weak_ptr<SQLStatementCache> cache);
+
+	void Release();
+};
+
+#endif /* SQLStatement_hpp */
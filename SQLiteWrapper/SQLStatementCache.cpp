@@ -0,0 +1,121 @@
+#include "SQLStatementCache.h"
+
+SQLStatementCache::SQLStatementCache(sqlite3 * db, size_t capacity) :
+	db(db), 
+	capacity(capacity)
+{
+}
+
+SQLStatementCache::~SQLStatementCache()
+{
+	this->Clear();
+}
+
+/// <summary>
+/// Get statement for the given SQL. Cached statement is removed from the cache
+/// and returned already reset and without bindings. 
+/// If there is no cached statement, a new one is prepared.
+/// </summary>
+/// <param name="sql"></param>
+/// <param name="errCode">result of sqlite3_prepare_v3 (SQLITE_OK for cache hit)</param>
+/// <returns>statement or nullptr if prepare failed</returns>
+sqlite3_stmt * SQLStatementCache::Acquire(const std::string & sql, int & errCode)
+{
+	{
+		std::lock_guard<std::mutex> lk(m);
+		auto it = mapping.find(sql);
+		if (it != mapping.end())
+		{
+			sqlite3_stmt * stmt = it->second->second;
+			lru.erase(it->second);
+			mapping.erase(it);
+
+			errCode = SQLITE_OK;
+			return stmt;
+		}
+	}
+
+	//statements kept in the cache are long living - 
+	//let SQLite know, so it can avoid using lookaside memory for them
+	unsigned int flags = (this->GetCapacity() > 0) ? SQLITE_PREPARE_PERSISTENT : 0;
+
+	sqlite3_stmt * stmt = nullptr;
+	errCode = sqlite3_prepare_v3(db, sql.c_str(), (int)sql.length(), flags, &stmt, nullptr);
+	return stmt;
+}
+
+/// <summary>
+/// Return statement back to the cache. 
+/// If the cache is disabled or there is already the same statement cached,
+/// statement is finalized.
+/// </summary>
+/// <param name="stmt"></param>
+void SQLStatementCache::Release(sqlite3_stmt * stmt)
+{
+	if (stmt == nullptr)
+	{
+		return;
+	}
+
+	sqlite3_reset(stmt);
+	sqlite3_clear_bindings(stmt);
+
+	const char * sql = sqlite3_sql(stmt);
+
+	std::lock_guard<std::mutex> lk(m);
+	if ((capacity == 0) || (sql == nullptr) || (mapping.find(sql) != mapping.end()))
+	{
+		sqlite3_finalize(stmt);
+		return;
+	}
+
+	lru.emplace_front(sql, stmt);
+	mapping[lru.front().first] = lru.begin();
+
+	this->EvictOverCapacity();
+}
+
+void SQLStatementCache::SetCapacity(size_t capacity)
+{
+	std::lock_guard<std::mutex> lk(m);
+	this->capacity = capacity;
+	this->EvictOverCapacity();
+}
+
+size_t SQLStatementCache::GetCapacity() const
+{
+	std::lock_guard<std::mutex> lk(m);
+	return capacity;
+}
+
+size_t SQLStatementCache::GetSize() const
+{
+	std::lock_guard<std::mutex> lk(m);
+	return lru.size();
+}
+
+void SQLStatementCache::Clear()
+{
+	std::lock_guard<std::mutex> lk(m);
+	for (auto & it : lru)
+	{
+		sqlite3_finalize(it.second);
+	}
+	lru.clear();
+	mapping.clear();
+}
+
+/// <summary>
+/// Finalize least recently used statements until cache fits into capacity.
+/// Must be called with locked mutex
+/// </summary>
+void SQLStatementCache::EvictOverCapacity()
+{
+	while (lru.size() > capacity)
+	{
+		auto & last = lru.back();
+		sqlite3_finalize(last.second);
+		mapping.erase(last.first);
+		lru.pop_back();
+	}
+}
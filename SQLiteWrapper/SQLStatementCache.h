@@ -0,0 +1,49 @@
+#ifndef SQLStatementCache_hpp
+#define SQLStatementCache_hpp
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+
+#include "sqlite3.h"
+
+/// <summary>
+/// Bounded LRU cache of prepared statements keyed by SQL text.
+/// It is owned by SQLiteWrapper (one cache per connection).
+/// 
+/// Statement that is handed out by Acquire is removed from the cache, 
+/// so the same SQL used twice at the same time gets two independent statements.
+/// Once the last SQLQuery / SQLResult holding the statement is destroyed,
+/// statement is reset, its bindings are cleared and it is returned via Release.
+/// If there is no free space, the least recently used statement is finalized.
+/// </summary>
+class SQLStatementCache
+{
+public:
+	SQLStatementCache(sqlite3 * db, size_t capacity);
+	~SQLStatementCache();
+
+	sqlite3_stmt * Acquire(const std::string & sql, int & errCode);
+	void Release(sqlite3_stmt * stmt);
+
+	void SetCapacity(size_t capacity);
+	size_t GetCapacity() const;
+	size_t GetSize() const;
+
+	void Clear();
+
+private:
+	typedef std::list<std::pair<std::string, sqlite3_stmt *>> LruList;
+
+	sqlite3 * db;
+	size_t capacity;
+
+	mutable std::mutex m;
+	LruList lru;
+	std::unordered_map<std::string, LruList::iterator> mapping;
+
+	void EvictOverCapacity();
+};
+
+#endif /* SQLStatementCache_hpp */
@@ -1,6 +1,14 @@
 #include "./SQLTable.h"
 
+#include <cstring>
+#include <cstdio>
+#include <cctype>
+#include <charconv>
+#include <deque>
+#include <stdexcept>
+
 #include "SQLiteWrapper.h"
+#include "SQLMappedFile.h"
 
 SQLTable::SQLTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper) :
 	name(name), wrapper(wrapper)
@@ -20,29 +28,473 @@ std::string SQLTable::ToCSV() const
 std::string SQLTable::ToCSV(const std::string & columns,
 	const std::string & delimeter) const
 {
+	CSVOptions opts;
+	opts.columns = columns;
+	opts.delimeter = delimeter;
 
-	std::string header = "";
 	std::string content = "";
+	this->WriteCSV([&](const char * data, size_t length) {
+		content.append(data, length);
+	}, opts);
+
+	return content;
+}
+
+/// <summary>
+/// Stream table content as CSV to sink. 
+/// Data are buffered and passed to sink in chunks of about opts.bufferSize,
+/// so the whole table is never kept in memory.
+/// </summary>
+/// <param name="sink"></param>
+/// <param name="opts"></param>
+void SQLTable::WriteCSV(const CSVSink & sink, const CSVOptions & opts) const
+{
+	std::string buffer;
+	buffer.reserve(opts.bufferSize + 1024);
+
+	auto appendValue = [&](const char * data, size_t len) {
+		if ((opts.quote == false) || (data == nullptr))
+		{
+			buffer.append(data, len);
+			return;
+		}
+
+		//RFC 4180 - values with delimeter, quotes or line breaks are enclosed in quotes
+		//and quotes inside are doubled
+		bool needsQuote = false;
+		for (size_t i = 0; i < len; i++)
+		{
+			char c = data[i];
+			if ((c == '"') || (c == '\n') || (c == '\r') || 
+				(opts.delimeter.find(c) != std::string::npos))
+			{
+				needsQuote = true;
+				break;
+			}
+		}
+
+		if (needsQuote == false)
+		{
+			buffer.append(data, len);
+			return;
+		}
+
+		buffer += '"';
+		const char * start = data;
+		const char * end = data + len;
+		while (const char * q = static_cast<const char *>(memchr(start, '"', end - start)))
+		{
+			buffer.append(start, q - start + 1);
+			buffer += '"';
+			start = q + 1;
+		}
+		buffer.append(start, end - start);
+		buffer += '"';
+	};
+
+	auto endLine = [&]() {
+		if (opts.trailingDelimeter == false)
+		{
+			buffer.resize(buffer.length() - opts.delimeter.length());
+		}
+		buffer += opts.lineEnd;
+
+		if (buffer.length() >= opts.bufferSize)
+		{
+			sink(buffer.data(), buffer.length());
+			buffer.clear();
+		}
+	};
+
+	auto query = this->wrapper->Query("SELECT " + opts.columns + " FROM " + name);
+
+	if (opts.header)
+	{
+		auto names = query.GetColumnNames();
+		for (auto & n : names)
+		{
+			appendValue(n.c_str(), n.length());
+			buffer += opts.delimeter;
+		}
+		endLine();
+	}
+
+	auto result = query.Select();
+	int cCount = result.ColumnCount();
 
-	auto result = this->wrapper->Query("SELECT " + columns + " FROM " + name).Select();
-	for (auto r : result)
+	for (auto & r : result)
 	{
-		int cCount = r.ColumnCount();
-		header = "";
 		for (int i = 0; i < cCount; i++)
 		{
-			header += r[i].GetColumnName();
-			header += delimeter;
+			int len = 0;
+			const char * data = r[i].as_cstr(len);
+			appendValue(data, static_cast<size_t>(len));
+			buffer += opts.delimeter;
+		}
+		endLine();
+	}
+
+	if (buffer.length() > 0)
+	{
+		sink(buffer.data(), buffer.length());
+	}
+}
+
+void SQLTable::WriteCSV(std::ostream & os, const CSVOptions & opts) const
+{
+	this->WriteCSV([&](const char * data, size_t length) {
+		os.write(data, static_cast<std::streamsize>(length));
+	}, opts);
+}
+
+/// <summary>
+/// Stream table content as CSV to file
+/// </summary>
+/// <param name="path"></param>
+/// <param name="opts"></param>
+/// <returns>false if file can not be opened or written</returns>
+bool SQLTable::WriteCSV(const std::string & path, const CSVOptions & opts) const
+{
+	FILE * f = fopen(path.c_str(), "wb");
+	if (f == nullptr)
+	{
+		return false;
+	}
+
+	//output is already buffered
+	setvbuf(f, nullptr, _IONBF, 0);
+
+	bool ok = true;
+	this->WriteCSV([&](const char * data, size_t length) {
+		ok = ok && (fwrite(data, 1, length, f) == length);
+	}, opts);
+
+	fclose(f);
+	return ok;
+}
+
+/// <summary>
+/// Import CSV file into the table. 
+/// File is memory mapped and values are bound directly from the mapping (SQLITE_STATIC),
+/// only quoted values with escaped quotes are copied.
+/// </summary>
+/// <param name="path"></param>
+/// <param name="opts"></param>
+/// <param name="rejectedRows">optional output - number of skipped rows (see ImportCSVData)</param>
+/// <returns>number of inserted rows, std::runtime_error is thrown if the file can not be opened</returns>
+size_t SQLTable::ImportCSV(const std::string & path, const CSVImportOptions & opts, 
+	size_t * rejectedRows)
+{
+	SQLMappedFile file(path);
+	if (file.IsOpen() == false)
+	{
+		throw std::runtime_error("Failed to open CSV file: " + path);
+	}
+
+	return this->ImportCSVData(file.GetData(), file.GetSize(), opts, rejectedRows);
+}
+
+/// <summary>
+/// Import CSV content into the table.
+/// Rows are inserted with a single reused statement, commited 
+/// every opts.rowsPerTransaction rows.
+/// Missing values are inserted as NULL, values over the column count are ignored
+/// 
+/// If a row can not be inserted, SQLException is thrown and the current transaction
+/// is rolled back (rows commited by previous transactions are kept).
+/// With opts.skipInvalidRows, rows violating constraints are skipped and counted instead.
+/// Other errors (e.g. busy database) are always thrown
+/// </summary>
+/// <param name="data"></param>
+/// <param name="length"></param>
+/// <param name="opts"></param>
+/// <param name="rejectedRows">optional output - number of skipped rows</param>
+/// <returns>number of inserted rows</returns>
+size_t SQLTable::ImportCSVData(const char * data, size_t length, const CSVImportOptions & opts, 
+	size_t * rejectedRows)
+{
+	const char * p = data;
+	const char * end = data + length;
+
+	//skip UTF-8 BOM
+	if ((length >= 3) && (memcmp(p, "\xEF\xBB\xBF", 3) == 0))
+	{
+		p += 3;
+	}
+
+	std::vector<std::string_view> fields;
+	std::deque<std::string> unescaped;	//deque - views of existing items stay valid when it grows
+
+	//read one line into fields, p is moved to the start of the next line
+	auto readLine = [&]() {
+		fields.clear();
+
+		const char * lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+		if (lineEnd == nullptr) lineEnd = end;
+
+		while (true)
+		{
+			std::string_view field;
 
-			content += r[i].as_string();
-			content += delimeter;
+			if ((opts.quote) && (p < end) && (*p == '"'))
+			{
+				const char * start = ++p;
+				const char * fieldEnd = end;
+				bool escaped = false;
+
+				while (const char * q = static_cast<const char *>(memchr(p, '"', end - p)))
+				{
+					if ((q + 1 < end) && (q[1] == '"'))
+					{
+						escaped = true;
+						p = q + 2;
+						continue;
+					}
+					fieldEnd = q;
+					break;
+				}
+				p = (fieldEnd < end) ? fieldEnd + 1 : end;
+				
+				field = std::string_view(start, fieldEnd - start);
+				if (escaped)
+				{
+					if (unescaped.size() <= fields.size())
+					{
+						unescaped.resize(fields.size() + 1);
+					}
+					std::string & tmp = unescaped[fields.size()];
+					tmp.clear();
+					for (size_t i = 0; i < field.length(); i++)
+					{
+						tmp += field[i];
+						if (field[i] == '"') i++;
+					}
+					field = tmp;
+				}
+
+				//quoted value may contain line breaks
+				if (p > lineEnd)
+				{
+					lineEnd = static_cast<const char *>(memchr(p, '\n', end - p));
+					if (lineEnd == nullptr) lineEnd = end;
+				}
+			}
+			else
+			{
+				const char * d = static_cast<const char *>(memchr(p, opts.delimeter, lineEnd - p));
+				const char * fieldEnd = (d != nullptr) ? d : lineEnd;
+				field = std::string_view(p, fieldEnd - p);
+				p = fieldEnd;
+			}
+
+			fields.push_back(field);
+
+			//move after delimeter, anything between closing quote and delimeter is ignored
+			const char * d = static_cast<const char *>(memchr(p, opts.delimeter, lineEnd - p));
+			if (d == nullptr)
+			{
+				break;
+			}
+			p = d + 1;
+		}
+
+		//CRLF line end
+		std::string_view & last = fields.back();
+		if ((last.length() > 0) && (last.back() == '\r') && (last.data() + last.length() == lineEnd))
+		{
+			last.remove_suffix(1);
+		}
+
+		p = (lineEnd < end) ? lineEnd + 1 : end;
+	};
+
+	std::vector<TableEntry> columns = opts.columns;
+	std::vector<size_t> fieldIndex;	//position of the field for each column
+	if (opts.header && (p < end))
+	{
+		readLine();
+		if (columns.empty())
+		{
+			auto schema = this->GetColumns();
+			for (size_t i = 0; i < fields.size(); i++)
+			{
+				//fields without name are ignored, position of the following fields is kept
+				if (fields[i].empty()) continue;
+
+				TableEntry e = { std::string(fields[i]), SQLEnums::ValueDataType::String };
+				for (auto & s : schema)
+				{
+					if (s.name == e.name) e.type = s.type;
+				}
+				columns.push_back(e);
+				fieldIndex.push_back(i);
+			}
 		}
-		content += "\n";
 	}
 
-	content = header + "\n" + content;
+	if (columns.empty())
+	{
+		columns = this->GetColumns();
+	}
 
-	return content;
+	if (fieldIndex.empty())
+	{
+		for (size_t i = 0; i < columns.size(); i++)
+		{
+			fieldIndex.push_back(i);
+		}
+	}
+
+	if (columns.empty())
+	{
+		return 0;
+	}
+
+	std::vector<std::string> names;
+	for (auto & c : columns)
+	{
+		names.push_back(c.name);
+	}
+	
+	SQLQuery query = this->wrapper->Query(SQLBulkInserter::CreateInsertSQL(name, names, 1));
+	sqlite3_stmt * stmt = query.stmt.get();
+
+	size_t cCount = columns.size();
+	size_t count = 0;
+	size_t rejected = 0;
+	size_t inTransaction = 0;
+
+	auto transaction = this->wrapper->BeginTransaction(SQLTransaction::Mode::Immediate);
+
+	while (p < end)
+	{
+		readLine();
+
+		//empty line
+		if ((fields.size() == 1) && (fields[0].empty()))
+		{
+			continue;
+		}
+
+		for (size_t i = 0; i < cCount; i++)
+		{
+			int index = static_cast<int>(i) + 1;
+			size_t fi = fieldIndex[i];
+
+			if ((fi >= fields.size()) || (opts.emptyAsNull && fields[fi].empty()))
+			{
+				SQLITE_CHECK_THROW(sqlite3_bind_null(stmt, index), stmt);
+				continue;
+			}
+
+			std::string_view v = fields[fi];
+			const char * vEnd = v.data() + v.length();
+
+			if (columns[i].type == SQLEnums::ValueDataType::Integer)
+			{
+				sqlite3_int64 iv = 0;
+				auto res = std::from_chars(v.data(), vEnd, iv);
+				if ((res.ec == std::errc()) && (res.ptr == vEnd))
+				{
+					SQLITE_CHECK_THROW(sqlite3_bind_int64(stmt, index, iv), stmt);
+					continue;
+				}
+			}
+#if defined(__cpp_lib_to_chars)
+			else if (columns[i].type == SQLEnums::ValueDataType::Float)
+			{
+				double dv = 0;
+				auto res = std::from_chars(v.data(), vEnd, dv);
+				if ((res.ec == std::errc()) && (res.ptr == vEnd))
+				{
+					SQLITE_CHECK_THROW(sqlite3_bind_double(stmt, index, dv), stmt);
+					continue;
+				}
+			}
+#endif
+			else if (columns[i].type == SQLEnums::ValueDataType::Blob)
+			{
+				SQLITE_CHECK_THROW(sqlite3_bind_blob64(stmt, index, v.data(), v.length(), SQLITE_STATIC), stmt);
+				continue;
+			}
+
+			//text or value that can not be converted - column affinity is applied by SQLite
+			SQLITE_CHECK_THROW(sqlite3_bind_text64(stmt, index, v.data(), v.length(), SQLITE_STATIC, SQLITE_UTF8), stmt);
+		}
+
+		int r = sqlite3_step(stmt);
+		if (r == SQLITE_DONE)
+		{
+			count++;
+			sqlite3_reset(stmt);
+		}
+		else if ((opts.skipInvalidRows) && 
+			(((r & 0xFF) == SQLITE_CONSTRAINT) || ((r & 0xFF) == SQLITE_MISMATCH) || ((r & 0xFF) == SQLITE_TOOBIG)))
+		{
+			rejected++;
+			sqlite3_reset(stmt);
+		}
+		else
+		{
+			//current transaction is rolled back by its destructor
+			SQLException::ThrowStep(r, stmt);
+		}
+
+		inTransaction++;
+		if ((opts.rowsPerTransaction > 0) && (inTransaction >= opts.rowsPerTransaction))
+		{
+			transaction.Commit();
+			transaction = this->wrapper->BeginTransaction(SQLTransaction::Mode::Immediate);
+			inTransaction = 0;
+		}
+	}
+
+	transaction.Commit();
+
+	//bound values point to the input data
+	sqlite3_clear_bindings(stmt);
+
+	if (rejectedRows != nullptr)
+	{
+		*rejectedRows = rejected;
+	}
+
+	return count;
+}
+
+/// <summary>
+/// Get table columns with types derived from declared type 
+/// (same rules as SQLite type affinity)
+/// </summary>
+/// <returns></returns>
+std::vector<SQLTable::TableEntry> SQLTable::GetColumns() const
+{
+	std::vector<TableEntry> columns;
+
+	auto res = wrapper->Query("PRAGMA table_info(" + name + ")").Select();
+	for (auto & r : res)
+	{
+		std::string type = r[2].as_string();
+		for (auto & c : type)
+		{
+			c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+		}
+
+		TableEntry e;
+		e.name = r[1].as_string();
+		
+		if (type.find("INT") != std::string::npos) e.type = SQLEnums::ValueDataType::Integer;
+		else if ((type.find("CHAR") != std::string::npos) || (type.find("CLOB") != std::string::npos) ||
+			(type.find("TEXT") != std::string::npos)) e.type = SQLEnums::ValueDataType::String;
+		else if (type.find("BLOB") != std::string::npos) e.type = SQLEnums::ValueDataType::Blob;
+		else if ((type.find("REAL") != std::string::npos) || (type.find("FLOA") != std::string::npos) ||
+			(type.find("DOUB") != std::string::npos)) e.type = SQLEnums::ValueDataType::Float;
+		else e.type = SQLEnums::ValueDataType::String;
+
+		columns.push_back(e);
+	}
+
+	return columns;
 }
 
 
@@ -81,8 +533,24 @@ void SQLTable::AddColumn(const std::string & colName, SQLEnums::ValueDataType ty
 //==============================================================================
 
 
-SQLKeyValueTable::SQLKeyValueTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper)
-	: SQLTable(name, wrapper)
+/// <summary>
+/// Create key-value table.
+/// If useCache is true, all values are loaded at once and served from memory.
+/// Changes are written back on Flush, after auto-flush interval or in destructor
+/// </summary>
+/// <param name="name"></param>
+/// <param name="wrapper"></param>
+/// <param name="useCache"></param>
+SQLKeyValueTable::SQLKeyValueTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper,
+	bool useCache)
+	: SQLTable(name, wrapper), 
+	enableNotregisteredKeysRemoval(false),
+	hasKeyIndex(false),
+	useCache(useCache),
+	cacheVersion(1),
+	dirtyCount(0),
+	autoFlushInterval(0),
+	lastFlushTime(std::chrono::steady_clock::now())
 {	
 	if (wrapper->ExistTable(name) == false)
 	{
@@ -93,20 +561,210 @@ SQLKeyValueTable::SQLKeyValueTable(const std::string & name, std::shared_ptr<SQL
 			"", false);
 	}
 	
-	//this->updateQuery = wrapper->Query("UPDATE " + name + " SET value=? WHERE key=?");
-	//this->selectQuery = wrapper->Query("SELECT value FROM " + name + " WHERE key=?");
-	
+	this->hasKeyIndex = this->CreateKeyIndex();
+
+	this->selectQuery = wrapper->Query("SELECT value FROM " + name + " WHERE key=?");
+	this->updateQuery = wrapper->Query("UPDATE " + name + " SET value=? WHERE key=?");
+	if (hasKeyIndex)
+	{
+		this->insertQuery = wrapper->Query("INSERT INTO " + name + " (key, value) VALUES(?, ?) "
+			"ON CONFLICT(key) DO NOTHING");
+		this->upsertQuery = wrapper->Query("INSERT INTO " + name + " (key, value) VALUES(?, ?) "
+			"ON CONFLICT(key) DO UPDATE SET value=excluded.value");
+	}
+	else
+	{
+		this->insertQuery = wrapper->Query("INSERT INTO " + name + " (key, value) SELECT ?1, ?2 "
+			"WHERE NOT EXISTS (SELECT 1 FROM " + name + " WHERE key=?1)");
+	}
+	this->existQuery = wrapper->Query("SELECT 1 FROM " + name + " WHERE key=? LIMIT 1");
+	this->removeQuery = wrapper->Query("DELETE FROM " + name + " WHERE key=?");
+
+	if (useCache)
+	{
+		this->LoadCache();
+	}
 }
 
 SQLKeyValueTable::~SQLKeyValueTable()
 {
-	
+	//exception must not leave destructor
+	try
+	{
+		this->Flush();
+	}
+	catch (const std::exception & e)
+	{
+		SQL_LOG("SQLKeyValueTable flush failed: %s\n", e.what());
+	}
+}
+
+bool SQLKeyValueTable::IsCacheEnabled() const
+{
+	return useCache;
+}
+
+/// <summary>
+/// Write all changed cached values to DB in a single transaction.
+/// Values are marked clean only after the commit succeeds, so a failed
+/// Flush (SQLException is thrown) can be retried
+/// </summary>
+void SQLKeyValueTable::Flush()
+{
+	lastFlushTime = std::chrono::steady_clock::now();
+
+	if (dirtyCount == 0)
+	{
+		return;
+	}
+
+	std::vector<CacheEntry *> written;
+	written.reserve(dirtyCount);
+
+	auto transaction = wrapper->BeginTransaction();
+	for (auto & it : cache)
+	{
+		if (it.second.dirty)
+		{
+			this->Upsert(it.first, it.second.value);
+			written.push_back(&it.second);
+		}
+	}
+	transaction.Commit();
+
+	for (CacheEntry * e : written)
+	{
+		e->dirty = false;
+	}
+	dirtyCount = 0;
+}
+
+/// <summary>
+/// Set interval for automatic flush of cached values.
+/// Interval is checked during writes, 0 disables auto-flush
+/// </summary>
+/// <param name="interval"></param>
+void SQLKeyValueTable::SetAutoFlushInterval(std::chrono::milliseconds interval)
+{
+	this->autoFlushInterval = interval;
+}
+
+void SQLKeyValueTable::AutoFlush()
+{
+	if (autoFlushInterval.count() <= 0)
+	{
+		return;
+	}
+
+	if (std::chrono::steady_clock::now() - lastFlushTime >= autoFlushInterval)
+	{
+		this->Flush();
+	}
+}
+
+/// <summary>
+/// Load all key-value pairs with a single query
+/// </summary>
+void SQLKeyValueTable::LoadCache()
+{
+	cache.clear();
+	dirtyCount = 0;
+
+	auto result = wrapper->Query("SELECT key, value FROM " + name).Select();
+	for (auto & row : result)
+	{
+		cache[row[0].as_string()] = { row[1].as_string(), false };
+	}
+	cacheVersion++;
+}
+
+void SQLKeyValueTable::SetCachedValue(const std::string & key, const std::string & value)
+{
+	CacheEntry & e = cache[key];
+	if (e.dirty == false)
+	{
+		e.dirty = true;
+		dirtyCount++;
+	}
+	e.value = value;
+	cacheVersion++;
+
+	this->AutoFlush();
+}
+
+const std::string * SQLKeyValueTable::GetCachedValue(const std::string & key) const
+{
+	auto it = cache.find(key);
+	if (it == cache.end())
+	{
+		return nullptr;
+	}
+	return &it->second.value;
+}
+
+/// <summary>
+/// Create UNIQUE index on key column. It is required for 
+/// INSERT ... ON CONFLICT(key) statements.
+/// Tables created by older versions do not have the index and 
+/// may contain duplicated keys. Such table is not modified - the index is not created
+/// and inserts / upserts check existing key with a separate query
+/// </summary>
+/// <returns>true if the index exists</returns>
+bool SQLKeyValueTable::CreateKeyIndex()
+{
+	std::string indexName = name + "_key_idx";
+	{
+		auto res = wrapper->Query("SELECT COUNT(*) FROM sqlite_master WHERE type='index' AND name=?").Select(indexName);
+		const SQLRow * row = res.GetNextRow();
+		if ((row != nullptr) && (row->at(0).as_int() != 0))
+		{
+			return true;
+		}
+	}
+
+	{
+		auto res = wrapper->Query("SELECT COUNT(*) - COUNT(DISTINCT key) FROM " + name).Select();
+		const SQLRow * row = res.GetNextRow();
+		long long duplicates = (row != nullptr) ? row->at(0).as_int64() : 0;
+		if (duplicates > 0)
+		{
+			SQL_LOG("SQLKeyValueTable %s: %lld duplicated keys, unique index not created\n", 
+				name.c_str(), duplicates);
+			return false;
+		}
+	}
+
+	wrapper->Query("CREATE UNIQUE INDEX IF NOT EXISTS " + indexName + " ON " + name + "(key)").Execute();
+	return true;
+}
+
+/// <summary>
+/// Insert key or update its value. Without the unique index, 
+/// ON CONFLICT can not be used - key is updated and inserted only if no row was changed
+/// </summary>
+/// <param name="key"></param>
+/// <param name="value"></param>
+void SQLKeyValueTable::Upsert(const std::string & key, const std::string & value)
+{
+	if (hasKeyIndex)
+	{
+		upsertQuery.Execute(key, value);
+		return;
+	}
+
+	updateQuery.Execute(value, key);
+	if (wrapper->GetChangesCount() == 0)
+	{
+		insertQuery.Execute(key, value);
+	}
 }
 
 void SQLKeyValueTable::Clear()
 {
-    //this->updateQuery.Reset();
-    //this->selectQuery.Reset();
+	cache.clear();
+	dirtyCount = 0;
+	cacheVersion++;
+
     SQLTable::Clear();
 }
 
@@ -121,12 +779,28 @@ void SQLKeyValueTable::DisableRemovalOfNonRegisteredKeys()
 	this->enableNotregisteredKeysRemoval = false;
 }
 
+void SQLKeyValueTable::RemoveNotRegisteredKeysNoThrow() noexcept
+{
+	try
+	{
+		this->RemoveNotRegisteredKeys();
+	}
+	catch (const std::exception & e)
+	{
+		SQL_LOG("SQLKeyValueTable key removal failed: %s\n", e.what());
+	}
+}
+
 void SQLKeyValueTable::RemoveNotRegisteredKeys()
 {
 	if (this->enableNotregisteredKeysRemoval == false)
 	{
 		return;
 	}
+
+	//cached non-registered keys must be in DB to be removed
+	this->Flush();
+
 	auto result = wrapper->Query("SELECT key FROM " + name + "").Select();
 	for (auto & row : result)
 	{
@@ -151,61 +825,92 @@ void SQLKeyValueTable::RemoveNotRegisteredKeys()
 
 bool SQLKeyValueTable::ExistKey(const std::string & key)
 {
-	auto results = wrapper->Query("SELECT COUNT(*) FROM " + name + " WHERE key=?").Select(key);
-	const SQLRow * row = results.GetNextRow();
-	if (row == nullptr)
+	if (useCache)
 	{
-		//something failed ?
-		return false;
+		return cache.find(key) != cache.end();
 	}
 
-	int count = row->at(0).as_int();
-	if (count != 0)
+	auto results = existQuery.Select(key);
+	const SQLRow * row = results.GetNextRow();
+	if (row == nullptr)
 	{
-		//alreday exist
-		return true;
+		return false;
 	}
 
-	return false;
+	//alreday exist
+	results.Reset();
+	return true;
 }
 
 void SQLKeyValueTable::AddNewKeyValue(const std::string & key, const std::string & value)
 {	
-	if (this->ExistKey(key))
+	if (useCache)
 	{
+		if (cache.find(key) == cache.end())
+		{
+			this->SetCachedValue(key, value);
+		}
 		return;
 	}
 
-	wrapper->Query("INSERT INTO " + name + " (key, value) VALUES(?, ?)").Execute(key, value);
+	insertQuery.Execute(key, value);
 }
 
 void SQLKeyValueTable::RemoveKey(const std::string & key)
 {
-	wrapper->Query("DELETE FROM " + name + " WHERE key=?").Execute(key);
+	if (useCache)
+	{
+		auto it = cache.find(key);
+		if (it != cache.end())
+		{
+			if (it->second.dirty) dirtyCount--;
+			cache.erase(it);
+			cacheVersion++;
+		}
+	}
+
+	removeQuery.Execute(key);
 }
 
 void SQLKeyValueTable::UpdateValue(const std::string & key, const std::string & newValue)
 {
-	wrapper->Query("UPDATE " + name + " SET value=? WHERE key=?").Execute(newValue, key);
-	//updateQuery.Execute(newValue, key);
+	if (useCache)
+	{
+		//same as UPDATE - non-existing key is not added
+		if (cache.find(key) != cache.end())
+		{
+			this->SetCachedValue(key, newValue);
+		}
+		return;
+	}
+
+	updateQuery.Execute(newValue, key);
 }
 
 void SQLKeyValueTable::AddNewKeyOrUpdateValue(const std::string & key, const std::string & value)
 {
-	if (this->ExistKey(key))
+	if (useCache)
 	{
-		this->UpdateValue(key, value);
+		this->SetCachedValue(key, value);
 		return;
 	}
 
-	this->AddNewKeyValue(key, value);
+	this->Upsert(key, value);
 }
 
 SQLResult SQLKeyValueTable::GetRowForValue(const std::string & key)
 {
-	return wrapper->Query("SELECT value FROM " + name + " WHERE key=?").Select(key);
-	//auto s = this->selectQuery.Select(key);
-	//return s.GetNextRow();
+	return selectQuery.Select(key);
 }
 
+//===============================================================================
+
+SQLSimpleKeyValueTable::~SQLSimpleKeyValueTable()
+{
+	this->RemoveNotRegisteredKeysNoThrow();
+}
 
+SQLAdvancedKeyValueTable::~SQLAdvancedKeyValueTable()
+{
+	this->RemoveNotRegisteredKeysNoThrow();
+}
@@ -15,6 +15,11 @@ class SQLRow;
 #include <string>
 #include <memory>
 #include <vector>
+#include <unordered_map>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <ostream>
 
 #include "./SQLEnums.h"
 #include "./SQLQuery.h"
@@ -27,15 +32,59 @@ public:
 		std::string name;
 		SQLEnums::ValueDataType type;		
 	} TableEntry;
+
+	typedef struct CSVOptions
+	{
+		std::string columns = "*";
+		std::string delimeter = "|";
+		std::string lineEnd = "\n";
+		bool header = true;
+		bool trailingDelimeter = true;	//delimeter after the last value of a line
+		bool quote = false;				//RFC 4180 quoting of values
+		size_t bufferSize = 64 * 1024;	//sink is called with chunks of about this size
+	} CSVOptions;
+
+	typedef std::function<void(const char * data, size_t length)> CSVSink;
+
+	typedef struct CSVImportOptions
+	{
+		//target columns with types used for binding
+		//if empty, names are taken from header (or all table columns) and types from table schema
+		std::vector<TableEntry> columns;
+		char delimeter = '|';
+		bool header = true;				//first line contains column names
+		bool quote = true;				//RFC 4180 quoted values
+		bool emptyAsNull = true;		//empty values are inserted as NULL
+		size_t rowsPerTransaction = 100000;	//0 - single transaction for the whole file
+		bool skipInvalidRows = false;	//skip rows failing on constraint / type mismatch instead of throwing
+	} CSVImportOptions;
 		
 	virtual ~SQLTable();
 	
 	std::string ToCSV() const;
 	std::string ToCSV(const std::string & columns, const std::string & delimeter) const;
 
+	void WriteCSV(const CSVSink & sink, const CSVOptions & opts) const;
+	void WriteCSV(std::ostream & os, const CSVOptions & opts) const;
+	bool WriteCSV(const std::string & path, const CSVOptions & opts) const;
+
+	size_t ImportCSV(const std::string & path, const CSVImportOptions & opts, 
+		size_t * rejectedRows = nullptr);
+	size_t ImportCSVData(const char * data, size_t length, const CSVImportOptions & opts, 
+		size_t * rejectedRows = nullptr);
+
 	virtual void Clear();
 	void AddColumn(const std::string & colName, SQLEnums::ValueDataType type);
 
+	//defined in SQLBulkInserter.h
+	template <typename Range>
+	size_t InsertRows(const std::vector<std::string> & columns, const Range & rows, 
+		int rowsPerStatement = 1);
+
+	template <typename Range, typename Projection>
+	size_t InsertRows(const std::vector<std::string> & columns, const Range & rows, 
+		Projection proj, int rowsPerStatement = 1);
+
 	friend class SQLiteWrapper;
 
 protected:
@@ -43,6 +92,8 @@ protected:
 	std::shared_ptr<SQLiteWrapper> wrapper;
 	
 	SQLTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper);
+
+	std::vector<TableEntry> GetColumns() const;
 };
 
 //===============================================================================
@@ -53,12 +104,15 @@ protected:
 class SQLKeyValueTable : public SQLTable
 {
 public:
-	SQLKeyValueTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper);
+	SQLKeyValueTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper,
+		bool useCache = false);
 	virtual ~SQLKeyValueTable();
 
     void Clear() override;
 
-	
+	bool IsCacheEnabled() const;
+	void Flush();
+	void SetAutoFlushInterval(std::chrono::milliseconds interval);
 
 	void EnableRemovalOfNonRegisteredKeys();
 	void DisableRemovalOfNonRegisteredKeys();
@@ -97,6 +151,7 @@ protected:
 		T value = T();
 		std::string key = "";
 		SQLKeyValueTable* parent = nullptr;
+		uint64_t cacheVersion = 0;
 
 		friend class SQLKeyValueTable;
 
@@ -112,14 +167,24 @@ protected:
 		T & operator = (const T &i) 
 		{ 
 			parent->UpdateValue(key, i);
+			//value may be stored in different format (std::to_string)
+			//next read must go through the parent again
+			cacheVersion = 0;
 			return value = i; 
 		};
 
 		// Implicit conversion back to T. 
+		// In cache mode, value is converted only if the cache has changed since last read
 		operator const T & () 
 		{ 
+			if ((parent->useCache) && (cacheVersion == parent->cacheVersion))
+			{
+				return value;
+			}
+
 			//value = parent->GetValue<std::decay<T>>(key);
 			value = parent->GetValue<typename std::decay<T>::type>(key);
+			cacheVersion = (parent->useCache) ? parent->cacheVersion : 0;
 			return value; 
 		};
 		
@@ -136,12 +201,42 @@ protected:
 
 
 	
-	//SQLQuery updateQuery;
-	//SQLQuery selectQuery;
+	//statements are prepared once in constructor and reused
+	SQLQuery selectQuery;
+	SQLQuery updateQuery;
+	SQLQuery insertQuery;
+	SQLQuery upsertQuery;
+	SQLQuery existQuery;
+	SQLQuery removeQuery;
+
 	std::vector<std::string> keys;
 	bool enableNotregisteredKeysRemoval;
+	bool hasKeyIndex;
+
+	typedef struct CacheEntry
+	{
+		std::string value;
+		bool dirty;
+	} CacheEntry;
+
+	//write-back cache of all key-value pairs (used only if useCache is true)
+	//cacheVersion is increased with every change of the cache
+	bool useCache;
+	std::unordered_map<std::string, CacheEntry> cache;
+	uint64_t cacheVersion;
+	size_t dirtyCount;
+	std::chrono::milliseconds autoFlushInterval;
+	std::chrono::steady_clock::time_point lastFlushTime;
 
 	void RemoveNotRegisteredKeys();
+	void RemoveNotRegisteredKeysNoThrow() noexcept;
+	bool CreateKeyIndex();
+	void Upsert(const std::string & key, const std::string & value);
+
+	void LoadCache();
+	void SetCachedValue(const std::string & key, const std::string & value);
+	void AutoFlush();
+	const std::string * GetCachedValue(const std::string & key) const;
 
 	template <typename T>
 	void RegisterPropertyName(KeyValueProperty<T> & p, const std::string & key, const T & defaultValue)
@@ -160,20 +255,22 @@ class SQLSimpleKeyValueTable : protected SQLKeyValueTable
 {
 public:
 
-	SQLSimpleKeyValueTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper)
-		: SQLKeyValueTable(name, wrapper) {	}
+	SQLSimpleKeyValueTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper, 
+		bool useCache = false)
+		: SQLKeyValueTable(name, wrapper, useCache) {	}
 
-	virtual ~SQLSimpleKeyValueTable() { this->RemoveNotRegisteredKeys(); }
+	virtual ~SQLSimpleKeyValueTable();
 };
 
 class SQLAdvancedKeyValueTable : public SQLKeyValueTable
 {
 public:
 
-	SQLAdvancedKeyValueTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper)
-		: SQLKeyValueTable(name, wrapper) {	}
+	SQLAdvancedKeyValueTable(const std::string & name, std::shared_ptr<SQLiteWrapper> wrapper, 
+		bool useCache = false)
+		: SQLKeyValueTable(name, wrapper, useCache) {	}
 
-	virtual ~SQLAdvancedKeyValueTable() { this->RemoveNotRegisteredKeys(); }
+	virtual ~SQLAdvancedKeyValueTable();
 };
 
 //===============================================================================
@@ -200,41 +297,62 @@ void SQLKeyValueTable::UpdateValue(const std::string & key, const T & newValue)
 template <typename T>
 RET_VAL_SAME(std::string) SQLKeyValueTable::GetValue(const std::string & key)
 {	
+	if (useCache)
+	{
+		const std::string * v = this->GetCachedValue(key);
+		return (v == nullptr) ? T() : *v;
+	}
+
 	auto s = this->GetRowForValue(key);
-	//auto s = this->selectQuery.Select(key);
 	auto tmp = s.GetNextRow();
     if (tmp == nullptr)
     {
         return T();
     }
-	return tmp->at(0).as_string();
+	T v = tmp->at(0).as_string();
+	s.Reset();
+	return v;
 };
 
 
 template <typename T>
 RET_VAL_GROUP(is_integral) SQLKeyValueTable::GetValue(const std::string & key)
 {
+	if (useCache)
+	{
+		const std::string * v = this->GetCachedValue(key);
+		return (v == nullptr) ? T() : static_cast<T>(std::strtoll(v->c_str(), nullptr, 10));
+	}
+
 	auto s = this->GetRowForValue(key);
-	//auto s = this->selectQuery.Select(key);
     auto tmp = s.GetNextRow();
     if (tmp == nullptr)
     {
         return T();
     }
-	return static_cast<T>(tmp->at(0).as_long());
+	T v = static_cast<T>(tmp->at(0).as_int64());
+	s.Reset();
+	return v;
 };
 
 template <typename T>
 RET_VAL_GROUP(is_floating_point) SQLKeyValueTable::GetValue(const std::string & key)
 {
+	if (useCache)
+	{
+		const std::string * v = this->GetCachedValue(key);
+		return (v == nullptr) ? T() : static_cast<T>(std::strtod(v->c_str(), nullptr));
+	}
+
 	auto s = this->GetRowForValue(key);
-	//auto s = this->selectQuery.Select(key);
     auto tmp = s.GetNextRow();
     if (tmp == nullptr)
     {
         return T();
     }
-	return static_cast<T>(tmp->at(0).as_double());
+	T v = static_cast<T>(tmp->at(0).as_double());
+	s.Reset();
+	return v;
 };
 
 
@@ -0,0 +1,139 @@
+#include "SQLTransaction.h"
+
+#include "SQLiteWrapper.h"
+
+SQLTransaction::SQLTransaction(std::shared_ptr<SQLiteWrapper> wrapper, Mode mode) :
+	wrapper(wrapper),
+	savepointName(""),
+	active(true)
+{
+	//autocommit is disabled by BEGIN and enabled after COMMIT / ROLLBACK
+	if (sqlite3_get_autocommit(wrapper->GetRawConnection()) == 0)
+	{
+		//savepoints are named by nesting depth, so the same few statements 
+		//are reused from the statement cache for all nested transactions
+		savepointName = "sp_" + std::to_string(wrapper->savepointDepth);
+		wrapper->Query("SAVEPOINT " + savepointName).Execute();
+		wrapper->savepointDepth++;
+		return;
+	}
+
+	switch (mode)
+	{
+	case Mode::Immediate: wrapper->Query("BEGIN IMMEDIATE").Execute(); break;
+	case Mode::Exclusive: wrapper->Query("BEGIN EXCLUSIVE").Execute(); break;
+	default: wrapper->Query("BEGIN DEFERRED").Execute(); break;
+	}
+}
+
+SQLTransaction::SQLTransaction(SQLTransaction && other) noexcept :
+	wrapper(std::move(other.wrapper)),
+	savepointName(std::move(other.savepointName)),
+	active(other.active)
+{
+	other.active = false;
+}
+
+/// <summary>
+/// Assign other transaction. Current one (if active) is rolled back
+/// </summary>
+/// <param name="other"></param>
+/// <returns></returns>
+SQLTransaction & SQLTransaction::operator =(SQLTransaction && other) noexcept
+{
+	if (this != &other)
+	{
+		this->RollbackNoThrow();
+
+		wrapper = std::move(other.wrapper);
+		savepointName = std::move(other.savepointName);
+		active = other.active;
+		other.active = false;
+	}
+	return *this;
+}
+
+SQLTransaction::~SQLTransaction()
+{
+	this->RollbackNoThrow();
+}
+
+/// <summary>
+/// Commit transaction. If it fails (SQLException is thrown), transaction stays active,
+/// so Commit can be retried (e.g. after SQLITE_BUSY) or the transaction rolled back
+/// </summary>
+void SQLTransaction::Commit()
+{
+	if (active == false)
+	{
+		return;
+	}
+
+	if (savepointName.empty())
+	{
+		wrapper->Query("COMMIT").Execute();
+		wrapper->savepointDepth = 0;
+	}
+	else
+	{
+		wrapper->Query("RELEASE " + savepointName).Execute();
+		if (wrapper->savepointDepth > 0) wrapper->savepointDepth--;
+	}
+	active = false;
+}
+
+void SQLTransaction::Rollback()
+{
+	if (active == false)
+	{
+		return;
+	}
+	active = false;
+
+	//transaction may have been already rolled back by SQLite after an error
+	bool inTransaction = (sqlite3_get_autocommit(wrapper->GetRawConnection()) == 0);
+
+	if (savepointName.empty())
+	{
+		wrapper->savepointDepth = 0;
+		if (inTransaction)
+		{
+			wrapper->Query("ROLLBACK").Execute();
+		}
+	}
+	else
+	{
+		if (wrapper->savepointDepth > 0) wrapper->savepointDepth--;
+		if (inTransaction)
+		{
+			//ROLLBACK TO does not remove savepoint from the stack
+			wrapper->Query("ROLLBACK TO " + savepointName).Execute();
+			wrapper->Query("RELEASE " + savepointName).Execute();
+		}
+	}
+}
+
+/// <summary>
+/// Rollback used from destructor / move assignment, errors are only logged
+/// </summary>
+void SQLTransaction::RollbackNoThrow() noexcept
+{
+	try
+	{
+		this->Rollback();
+	}
+	catch (const std::exception & e)
+	{
+		SQL_LOG("SQLTransaction rollback failed: %s\n", e.what());
+	}
+}
+
+bool SQLTransaction::IsActive() const
+{
+	return active;
+}
+
+bool SQLTransaction::IsSavepoint() const
+{
+	return (savepointName.empty() == false);
+}
@@ -0,0 +1,54 @@
+#ifndef SQLTransaction_hpp
+#define SQLTransaction_hpp
+
+#include <memory>
+#include <string>
+
+class SQLiteWrapper;
+
+/// <summary>
+/// RAII transaction. Created by SQLiteWrapper::BeginTransaction.
+/// 
+/// If there is no active transaction on the connection, 
+/// BEGIN DEFERRED / IMMEDIATE / EXCLUSIVE is used. 
+/// If the transaction is created inside of another one, 
+/// SAVEPOINT is used instead (mode is ignored, it is given by the outer transaction).
+/// 
+/// If neither Commit nor Rollback is called, transaction is rolled back in destructor
+/// </summary>
+class SQLTransaction
+{
+public:
+	enum class Mode 
+	{
+		Deferred,
+		Immediate,
+		Exclusive
+	};
+
+	SQLTransaction(SQLTransaction && other) noexcept;
+	SQLTransaction(const SQLTransaction &) = delete;
+	SQLTransaction & operator =(const SQLTransaction &) = delete;
+	SQLTransaction & operator =(SQLTransaction && other) noexcept;
+
+	~SQLTransaction();
+
+	void Commit();
+	void Rollback();
+
+	bool IsActive() const;
+	bool IsSavepoint() const;
+
+	friend class SQLiteWrapper;
+
+protected:
+	std::shared_ptr<SQLiteWrapper> wrapper;
+	std::string savepointName;
+	bool active;
+
+	SQLTransaction(std::shared_ptr<SQLiteWrapper> wrapper, Mode mode);
+
+	void RollbackNoThrow() noexcept;
+};
+
+#endif /* SQLTransaction_hpp */
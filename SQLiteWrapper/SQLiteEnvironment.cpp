@@ -0,0 +1,128 @@
+#include "SQLiteEnvironment.h"
+
+#include <mutex>
+#include <memory>
+#include <cstdint>
+
+#include "SQLiteWrapper.h"
+
+static std::mutex environmentMutex;
+static bool environmentInitialized = false;
+static std::unique_ptr<uint8_t[]> pageCacheMemory;
+
+#define SQLITE_CONFIG_CHECK(stmt) do { \
+	int r = stmt; \
+	if (r != SQLITE_OK){ \
+		SQL_LOG("SQLite config error: %i - %s\n", r, #stmt); \
+		ok = false; \
+	} \
+	} while (0);
+
+/// <summary>
+/// Initialize SQLite with default settings.
+/// Does nothing if library is already initialized
+/// </summary>
+/// <returns>true if library is initialized</returns>
+bool SQLiteEnvironment::Initialize()
+{
+	return Initialize(Settings());
+}
+
+/// <summary>
+/// Configure and initialize SQLite. 
+/// Settings are applied only once, if library is already initialized, 
+/// this call does nothing. 
+/// </summary>
+/// <param name="settings"></param>
+/// <returns>true if library is initialized and all settings were applied</returns>
+bool SQLiteEnvironment::Initialize(const Settings & settings)
+{
+	std::lock_guard<std::mutex> lock(environmentMutex);
+	if (environmentInitialized)
+	{
+		return true;
+	}
+
+	bool ok = true;
+
+	if (sqlite3_threadsafe() != 0)
+	{
+		switch (settings.threading)
+		{
+		case ThreadingMode::SingleThread:
+			SQLITE_CONFIG_CHECK(sqlite3_config(SQLITE_CONFIG_SINGLETHREAD));
+			break;
+		case ThreadingMode::MultiThread:
+			SQLITE_CONFIG_CHECK(sqlite3_config(SQLITE_CONFIG_MULTITHREAD));
+			break;
+		case ThreadingMode::Serialized:
+			SQLITE_CONFIG_CHECK(sqlite3_config(SQLITE_CONFIG_SERIALIZED));
+			break;
+		}
+	}
+
+	SQLITE_CONFIG_CHECK(sqlite3_config(SQLITE_CONFIG_MEMSTATUS, settings.memoryStatus ? 1 : 0));
+
+	if (settings.allocator != nullptr)
+	{
+		SQLITE_CONFIG_CHECK(sqlite3_config(SQLITE_CONFIG_MALLOC, settings.allocator));
+	}
+
+	//config is kept by SQLite after shutdown, buffer from previous 
+	//initialization must not be used - always set it
+	if ((settings.pageCacheSlotSize > 0) && (settings.pageCacheSlotsCount > 0))
+	{
+		size_t size = static_cast<size_t>(settings.pageCacheSlotSize) * settings.pageCacheSlotsCount;
+		pageCacheMemory = std::unique_ptr<uint8_t[]>(new uint8_t[size]);
+		SQLITE_CONFIG_CHECK(sqlite3_config(SQLITE_CONFIG_PAGECACHE, pageCacheMemory.get(),
+			settings.pageCacheSlotSize, settings.pageCacheSlotsCount));
+	}
+	else
+	{
+		SQLITE_CONFIG_CHECK(sqlite3_config(SQLITE_CONFIG_PAGECACHE, nullptr, 0, 0));
+	}
+
+	if ((settings.lookasideSlotSize >= 0) && (settings.lookasideSlotsCount >= 0))
+	{
+		SQLITE_CONFIG_CHECK(sqlite3_config(SQLITE_CONFIG_LOOKASIDE, 
+			settings.lookasideSlotSize, settings.lookasideSlotsCount));
+	}
+
+	SQLITE_CONFIG_CHECK(sqlite3_config(SQLITE_CONFIG_URI, settings.uri ? 1 : 0));
+
+	//config fails if library was already initialized outside of this class
+	//(settings are then ignored, but the library is usable)
+	int r = sqlite3_initialize();
+	if (r != SQLITE_OK)
+	{
+		SQL_LOG("SQLite error: %i - %s\n", r, "sqlite3_initialize");
+		return false;
+	}
+
+	environmentInitialized = true;
+	return ok;
+}
+
+bool SQLiteEnvironment::IsInitialized()
+{
+	std::lock_guard<std::mutex> lock(environmentMutex);
+	return environmentInitialized;
+}
+
+/// <summary>
+/// Release all SQLite global resources. 
+/// All connections must be closed before.
+/// Library can be configured again with Initialize
+/// </summary>
+void SQLiteEnvironment::Shutdown()
+{
+	std::lock_guard<std::mutex> lock(environmentMutex);
+	if (environmentInitialized == false)
+	{
+		return;
+	}
+
+	SQLITE_CHECK(sqlite3_shutdown());
+	pageCacheMemory = nullptr;
+	environmentInitialized = false;
+}
@@ -0,0 +1,62 @@
+#ifndef SQLiteEnvironment_hpp
+#define SQLiteEnvironment_hpp
+
+#include <cstddef>
+
+#include "sqlite3.h"
+
+/// <summary>
+/// Process-wide SQLite configuration (sqlite3_config + sqlite3_initialize).
+/// 
+/// Global settings can only be changed before the library is initialized, 
+/// so Initialize should be called once at application start, before any 
+/// database is opened. If it is not called, the first opened SQLiteWrapper 
+/// initializes the library with default Settings.
+/// 
+/// Individual connections never touch the global state.
+/// Shutdown may be called only after all connections are closed.
+/// </summary>
+class SQLiteEnvironment
+{
+public:
+	enum class ThreadingMode
+	{
+		SingleThread,	//no mutexes at all, SQLite must be used from a single thread
+		MultiThread,	//connections must not be shared between threads at the same time
+		Serialized		//connections can be shared between threads
+	};
+
+	typedef struct Settings
+	{
+		ThreadingMode threading = ThreadingMode::Serialized;
+		
+		//memory usage statistics, disabling them removes a global mutex from every allocation
+		bool memoryStatus = true;
+
+		//custom memory allocator (nullptr - SQLite default)
+		const sqlite3_mem_methods * allocator = nullptr;
+
+		//preallocated page cache, slot size in bytes must be page size + 
+		//page header (about 40 bytes), 0 - allocated on demand
+		int pageCacheSlotSize = 0;
+		int pageCacheSlotsCount = 0;
+
+		//default lookaside memory for each connection, -1 - SQLite default
+		int lookasideSlotSize = -1;
+		int lookasideSlotsCount = -1;
+
+		//URI filenames accepted by all connections
+		bool uri = false;
+	} Settings;
+
+	static bool Initialize();
+	static bool Initialize(const Settings & settings);
+	static bool IsInitialized();
+
+	static void Shutdown();
+
+private:
+	SQLiteEnvironment() = delete;
+};
+
+#endif /* SQLiteEnvironment_hpp */
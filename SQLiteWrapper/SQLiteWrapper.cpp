@@ -11,6 +11,8 @@
 
 #include "SQLResult.h"
 #include "SQLRow.h"
+#include "SQLStatementCache.h"
+#include "SQLiteEnvironment.h"
 
 
 std::shared_ptr<SQLiteWrapper> SQLiteWrapper::Open(const std::string & path, int mode)
@@ -18,16 +20,30 @@ std::shared_ptr<SQLiteWrapper> SQLiteWrapper::Open(const std::string & path, int
 	return std::shared_ptr<SQLiteWrapper>(new SQLiteWrapper(path, mode));	
 }
 
-SQLiteWrapper::SQLiteWrapper(const std::string & path, int mode) : db(nullptr)
+/// <summary>
+/// Open database and apply tuning options before the connection is used
+/// (see SQLConnectionOptions::Preset for named presets).
+/// Options that can not be applied are logged
+/// </summary>
+/// <param name="path"></param>
+/// <param name="mode"></param>
+/// <param name="options"></param>
+/// <returns></returns>
+std::shared_ptr<SQLiteWrapper> SQLiteWrapper::Open(const std::string & path, int mode,
+	const SQLConnectionOptions & options)
 {
-	SQLITE_CHECK(sqlite3_shutdown());
+	auto wrapper = SQLiteWrapper::Open(path, mode);
+	wrapper->Configure(options);
+	return wrapper;
+}
 
-    int threadSafe = sqlite3_threadsafe();
-	
-    if (threadSafe == 1)
-    {
-        SQLITE_CHECK(sqlite3_config(SQLITE_CONFIG_SERIALIZED));
-    }
+SQLiteWrapper::SQLiteWrapper(const std::string & path, int mode) : 
+	db(nullptr),
+	savepointDepth(0)
+{
+	//global state is configured only once per process, 
+	//other open connections must not be affected
+	SQLiteEnvironment::Initialize();
     
     int flag = 0;
     if (mode & SQLEnums::OpenMode::Create) flag |= SQLITE_OPEN_CREATE;
@@ -42,12 +58,17 @@ SQLiteWrapper::SQLiteWrapper(const std::string & path, int mode) : db(nullptr)
 
     
     SQLITE_CHECK(sqlite3_open_v2(path.c_str(), &db, flag, nullptr));
+
+	stmtCache = std::shared_ptr<SQLStatementCache>(new SQLStatementCache(db, DEFAULT_STATEMENT_CACHE_SIZE));
 }
 
 SQLiteWrapper::~SQLiteWrapper()
 {
+	//statements still in use (SQLQuery / SQLResult alive) are finalized
+	//by their owners, connection is closed once the last one is gone (close_v2)
+	stmtCache = nullptr;
+
 	SQLITE_CHECK(sqlite3_close_v2( db ));
-	SQLITE_CHECK(sqlite3_shutdown());
 }
 
 sqlite3 * SQLiteWrapper::GetRawConnection()
@@ -55,6 +76,99 @@ sqlite3 * SQLiteWrapper::GetRawConnection()
     return this->db;
 }
 
+/// <summary>
+/// Apply connection options via PRAGMA statements. 
+/// Must be called outside of transaction.
+/// </summary>
+/// <param name="options"></param>
+/// <returns>false if some of the options was not applied</returns>
+bool SQLiteWrapper::Configure(const SQLConnectionOptions & options)
+{
+	typedef SQLConnectionOptions Opt;
+
+	bool ok = true;
+	auto pragma = [&](const std::string & value) {
+		int r = sqlite3_exec(db, ("PRAGMA " + value).c_str(), nullptr, nullptr, nullptr);
+		if (r != SQLITE_OK)
+		{
+			SQL_LOG("Failed to set PRAGMA %s - %s\n", value.c_str(), sqlite3_errmsg(db));
+			ok = false;
+		}
+	};
+
+	//changing journal mode may need to wait for other connections
+	if (options.busyTimeout.has_value())
+	{
+		sqlite3_busy_timeout(db, *options.busyTimeout);
+	}
+
+	//page size can not be changed once the database is in WAL mode
+	if (options.pageSize.has_value())
+	{
+		pragma("page_size=" + std::to_string(*options.pageSize));
+	}
+
+	if (options.lockingMode.has_value())
+	{
+		pragma(std::string("locking_mode=") + 
+			((*options.lockingMode == Opt::LockingMode::Exclusive) ? "EXCLUSIVE" : "NORMAL"));
+	}
+
+	if (options.journalMode.has_value())
+	{
+		static const char * modes[] = { "delete", "truncate", "persist", "memory", "wal", "off" };
+		std::string mode = modes[static_cast<int>(*options.journalMode)];
+
+		//mode that is really used is returned (e.g. in-memory DB can not use WAL)
+		std::string current = "";
+		try
+		{
+			auto res = this->Query("PRAGMA journal_mode=" + mode).Select();
+			const SQLRow * row = res.GetNextRow();
+			current = (row != nullptr) ? row->at(0).as_string() : "";
+		}
+		catch (const SQLException & e)
+		{
+			current = e.what();
+		}
+
+		if (current != mode)
+		{
+			SQL_LOG("Failed to set journal_mode=%s (current mode: %s)\n", mode.c_str(), current.c_str());
+			ok = false;
+		}
+	}
+
+	if (options.synchronous.has_value())
+	{
+		static const char * levels[] = { "OFF", "NORMAL", "FULL", "EXTRA" };
+		pragma(std::string("synchronous=") + levels[static_cast<int>(*options.synchronous)]);
+	}
+
+	if (options.cacheSize.has_value())
+	{
+		pragma("cache_size=" + std::to_string(*options.cacheSize));
+	}
+
+	if (options.mmapSize.has_value())
+	{
+		pragma("mmap_size=" + std::to_string(*options.mmapSize));
+	}
+
+	if (options.tempStore.has_value())
+	{
+		static const char * stores[] = { "DEFAULT", "FILE", "MEMORY" };
+		pragma(std::string("temp_store=") + stores[static_cast<int>(*options.tempStore)]);
+	}
+
+	if (options.walAutoCheckpoint.has_value())
+	{
+		pragma("wal_autocheckpoint=" + std::to_string(*options.walAutoCheckpoint));
+	}
+
+	return ok;
+}
+
 std::string SQLiteWrapper::GetErrorMsg() const
 {
     return sqlite3_errmsg(db);
@@ -262,16 +376,92 @@ int SQLiteWrapper::GetCount(const std::string & table, const std::string & colNa
 }
 
 
+/// <summary>
+/// Create query from SQL. Prepared statements are cached per connection
+/// (LRU, keyed by SQL text), so repeated calls with the same SQL 
+/// do not run SQLite parser / planner again.
+/// </summary>
+/// <param name="query"></param>
+/// <returns></returns>
 SQLQuery SQLiteWrapper::Query( const std::string & query ) const
 {
-    sqlite3_stmt *stmt = 0;
-    int r = sqlite3_prepare_v2(db, query.c_str(), (int)query.length(), &stmt, 0);
+    int r = SQLITE_OK;
+    sqlite3_stmt *stmt = stmtCache->Acquire(query, r);
     if ((r != SQLITE_OK) && (r != SQLITE_DONE))
     {
-        SQL_LOG("SQLite error: %i - sqlite3_prepare_v2: %s\n", r, query.c_str());
+        SQLException::Throw(r, db, query.c_str());
     }
     
-    return SQLQuery( stmt );
+    return SQLQuery( stmt, stmtCache );
+}
+
+/// <summary>
+/// Get explicit statement handle for tight loops (see SQLStatement).
+/// Statement is taken from the statement cache and returned there once the handle is destroyed
+/// </summary>
+/// <param name="query"></param>
+/// <returns></returns>
+SQLStatement SQLiteWrapper::Prepare(const std::string & query) const
+{
+	int r = SQLITE_OK;
+	sqlite3_stmt * stmt = stmtCache->Acquire(query, r);
+	if ((r != SQLITE_OK) && (r != SQLITE_DONE))
+	{
+		SQLException::Throw(r, db, query.c_str());
+	}
+
+	return SQLStatement(stmt, stmtCache);
+}
+
+/// <summary>
+/// Set maximal number of cached prepared statements.
+/// 0 disables the cache (statements are finalized once not used)
+/// </summary>
+/// <param name="size"></param>
+void SQLiteWrapper::SetStatementCacheSize(size_t size)
+{
+	stmtCache->SetCapacity(size);
+}
+
+size_t SQLiteWrapper::GetStatementCacheSize() const
+{
+	return stmtCache->GetCapacity();
+}
+
+/// <summary>
+/// Start new transaction. If there is already an active transaction,
+/// SAVEPOINT is created instead, so transactions can be nested.
+/// Transaction is rolled back, if it is not commited before it is destroyed
+/// </summary>
+/// <param name="mode"></param>
+/// <returns></returns>
+SQLTransaction SQLiteWrapper::BeginTransaction(SQLTransaction::Mode mode)
+{
+	return SQLTransaction(shared_from_this(), mode);
+}
+
+/// <summary>
+/// Open blob for incremental read / write. 
+/// </summary>
+/// <param name="table"></param>
+/// <param name="column"></param>
+/// <param name="rowId"></param>
+/// <param name="writable"></param>
+/// <param name="dbName">"main", "temp" or name of attached DB</param>
+/// <returns>blob stream, SQLException is thrown if blob can not be opened</returns>
+std::shared_ptr<SQLBlobStream> SQLiteWrapper::OpenBlob(const std::string & table, const std::string & column,
+	sqlite3_int64 rowId, bool writable, const std::string & dbName)
+{
+	sqlite3_blob * blob = nullptr;
+	int r = sqlite3_blob_open(db, dbName.c_str(), table.c_str(), column.c_str(), rowId, writable ? 1 : 0, &blob);
+	if (r != SQLITE_OK)
+	{
+		SQLException e = SQLException::Create(r, db, "sqlite3_blob_open");
+		sqlite3_blob_close(blob);
+		throw e;
+	}
+
+	return std::shared_ptr<SQLBlobStream>(new SQLBlobStream(shared_from_this(), blob, writable));
 }
 
 int SQLiteWrapper::GetChangesCount() const
@@ -20,13 +20,20 @@
 #include "sqlite3.h"
 
 #include "SQLEnums.h"
+#include "SQLException.h"
 #include "SQLQuery.h"
+#include "SQLStatement.h"
 #include "SQLTable.h"
+#include "SQLTransaction.h"
+#include "SQLBlobStream.h"
+#include "SQLConnectionOptions.h"
+
+class SQLStatementCache;
 
 #ifdef __ANDROID_API__
-#	define SQL_LOG(s, r, p) __android_log_print(ANDROID_LOG_ERROR, "SQLite", s, r, p);
+#	define SQL_LOG(...) __android_log_print(ANDROID_LOG_ERROR, "SQLite", __VA_ARGS__);
 #else
-#	define SQL_LOG(s, r, p) printf(s, r, p)
+#	define SQL_LOG(...) printf(__VA_ARGS__)
 #endif
 
 #if defined(_DEBUG) || defined(DEBUG)
@@ -48,11 +55,15 @@ public:
         
 	
 	static std::shared_ptr<SQLiteWrapper> Open(const std::string & path, int mode);
+	static std::shared_ptr<SQLiteWrapper> Open(const std::string & path, int mode, 
+		const SQLConnectionOptions & options);
 
 	
     ~SQLiteWrapper();
     
     sqlite3 * GetRawConnection();
+
+	bool Configure(const SQLConnectionOptions & options);
     
     std::string GetErrorMsg() const;
     long long GetLastInsertID() const;
@@ -82,13 +93,28 @@ public:
 		const std::string & wherePart) const;
 
     SQLQuery Query( const std::string & query ) const;
+	SQLStatement Prepare(const std::string & query) const;
+
+	SQLTransaction BeginTransaction(SQLTransaction::Mode mode = SQLTransaction::Mode::Deferred);
+
+	std::shared_ptr<SQLBlobStream> OpenBlob(const std::string & table, const std::string & column,
+		sqlite3_int64 rowId, bool writable, const std::string & dbName = "main");
+
+	void SetStatementCacheSize(size_t size);
+	size_t GetStatementCacheSize() const;
 
 	int GetChangesCount() const;
 	
 	//friend class SQLTable;
+	friend class SQLTransaction;
 
 protected:
+    static const size_t DEFAULT_STATEMENT_CACHE_SIZE = 64;
+
     sqlite3 *db;
+	std::shared_ptr<SQLStatementCache> stmtCache;
+	int savepointDepth;	//number of active SQLTransaction savepoints
+
 	SQLiteWrapper(const std::string & path, int mode);
 	
 };
@@ -104,5 +130,6 @@ std::shared_ptr<T> SQLiteWrapper::OpenTable(const std::string & tableName)
 	return nullptr;
 }
 
+#include "SQLBulkInserter.h"
 
 #endif /* SQLiteWrapper_h */